@@ -0,0 +1,236 @@
+// Run-time cost of the basic operations of mr::any against std::any, and of mr::function against std::function and
+// raw function pointers: construction, copy, move, swap, cast and call for small, medium and large payloads.
+// Small payloads fit every inline buffer, medium ones fit mr::function's but not std::any's, large ones fit none.
+// Usage: any_function_benchmark [iterations] [--json]
+//  --json prints one JSON array of {"operation", "payload", "implementation", "ns_per_op"} objects instead of a table
+
+#include <algorithm>
+#include <any>
+#include <array>
+#include <chrono>
+#include <constexpr_any.h>
+#include <constexpr_function.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+    // Keeps the compiler from dropping or hoisting the measured work
+    template < class T >
+    inline void keep(T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(std::addressof(value)) : "memory");
+#else
+        static void* volatile sink;
+        sink = std::addressof(value);
+#endif
+    }
+
+    struct result {
+        std::string_view operation;
+        std::string_view payload;
+        std::string_view implementation;
+        double           ns_per_op;
+    };
+
+    inline std::vector< result > results {};
+
+    // Best of a few repetitions, in nanoseconds per call of Fn
+    template < class Fn >
+    void measure(std::string_view operation, std::string_view payload, std::string_view implementation,
+                 std::size_t iterations, Fn&& fn) {
+        double best = 0.;
+        for (int repetition = 0; repetition < 5; ++repetition) {
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < iterations; ++i) {
+                fn(i);
+            }
+            const auto elapsed =
+                std::chrono::duration< double, std::nano >(std::chrono::steady_clock::now() - start).count();
+            best = repetition == 0 ? elapsed : std::min(best, elapsed);
+        }
+        results.push_back(result { operation, payload, implementation, best / static_cast< double >(iterations) });
+    }
+
+    using small_payload  = int;
+    using medium_payload = std::array< void*, 3 >;
+    using large_payload  = std::array< char, 256 >;
+
+    struct std_any {
+        using type = std::any;
+
+        static constexpr std::string_view name = "std::any";
+
+        template < class T >
+        static const T* cast(const type& value) noexcept {
+            return std::any_cast< T >(std::addressof(value));
+        }
+    };
+
+    struct mr_any {
+        using type = mr::any;
+
+        static constexpr std::string_view name = "mr::any";
+
+        template < class T >
+        static const T* cast(const type& value) noexcept {
+            return mr::any_cast< T >(std::addressof(value));
+        }
+    };
+
+    template < class Impl, class Payload >
+    void run_any(std::string_view payload_name, std::size_t iterations) {
+        using Any = typename Impl::type;
+        const Payload payload {};
+
+        measure("construct", payload_name, Impl::name, iterations, [&](std::size_t) {
+            Any value { payload };
+            keep(value);
+        });
+
+        Any first { payload };
+        Any second { payload };
+        measure("copy", payload_name, Impl::name, iterations, [&](std::size_t) {
+            Any copy { first };
+            keep(copy);
+        });
+        // A move construction and a move assignment back, so that first keeps its value
+        measure("move", payload_name, Impl::name, iterations, [&](std::size_t) {
+            Any moved { std::move(first) };
+            keep(moved);
+            first = std::move(moved);
+        });
+        measure("swap", payload_name, Impl::name, iterations, [&](std::size_t) {
+            using std::swap;
+            swap(first, second);
+            keep(first);
+        });
+        measure("cast", payload_name, Impl::name, iterations, [&](std::size_t) {
+            const Payload* value = Impl::template cast< Payload >(first);
+            keep(value);
+        });
+    }
+
+    // Callables of each payload size returning an int from an int
+    template < class Payload >
+    struct callable {
+        int operator()(int value) const noexcept {
+            return value + static_cast< int >(sizeof(data));
+        }
+
+        Payload data {};
+    };
+
+    inline int add_four(int value) noexcept {
+        return value + 4;
+    }
+
+    template < class Function >
+    constexpr std::string_view function_name = "mr::function";
+    template <>
+    constexpr std::string_view function_name< std::function< int(int) > > = "std::function";
+
+    template < class Function, class Payload >
+    void run_function(std::string_view payload_name, std::size_t iterations) {
+        constexpr std::string_view name = function_name< Function >;
+        const callable< Payload >  target {};
+
+        measure("construct", payload_name, name, iterations, [&](std::size_t) {
+            Function fn { target };
+            keep(fn);
+        });
+
+        Function first { target };
+        Function second { target };
+        measure("copy", payload_name, name, iterations, [&](std::size_t) {
+            Function copy { first };
+            keep(copy);
+        });
+        measure("move", payload_name, name, iterations, [&](std::size_t) {
+            Function moved { std::move(first) };
+            keep(moved);
+            first = std::move(moved);
+        });
+        measure("swap", payload_name, name, iterations, [&](std::size_t) {
+            using std::swap;
+            swap(first, second);
+            keep(first);
+        });
+        measure("call", payload_name, name, iterations, [&](std::size_t i) {
+            int value = first(static_cast< int >(i));
+            keep(value);
+        });
+    }
+
+    void run_function_pointer(std::size_t iterations) {
+        int (*volatile source)(int) = &add_four;
+        int (*fn)(int)              = source;
+        measure("call", "small", "function pointer", iterations, [&](std::size_t i) {
+            keep(fn);
+            int value = fn(static_cast< int >(i));
+            keep(value);
+        });
+    }
+
+    void print_table() {
+        std::printf("%-10s %-8s %-18s %10s\n", "operation", "payload", "implementation", "ns/op");
+        for (const result& r : results) {
+            std::printf("%-10.*s %-8.*s %-18.*s %10.3f\n", static_cast< int >(r.operation.size()), r.operation.data(),
+                        static_cast< int >(r.payload.size()), r.payload.data(),
+                        static_cast< int >(r.implementation.size()), r.implementation.data(), r.ns_per_op);
+        }
+    }
+
+    void print_json() {
+        std::printf("[\n");
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const result& r = results[i];
+            std::printf("  {\"operation\": \"%.*s\", \"payload\": \"%.*s\", \"implementation\": \"%.*s\", "
+                        "\"ns_per_op\": %.4f}%s\n",
+                        static_cast< int >(r.operation.size()), r.operation.data(),
+                        static_cast< int >(r.payload.size()), r.payload.data(),
+                        static_cast< int >(r.implementation.size()), r.implementation.data(), r.ns_per_op,
+                        i + 1 == results.size() ? "" : ",");
+        }
+        std::printf("]\n");
+    }
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    std::size_t iterations = 1'000'000;
+    bool        json       = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else {
+            iterations = std::strtoull(argv[i], nullptr, 10);
+        }
+    }
+
+    bench::run_any< bench::std_any, bench::small_payload >("small", iterations);
+    bench::run_any< bench::mr_any, bench::small_payload >("small", iterations);
+    bench::run_any< bench::std_any, bench::medium_payload >("medium", iterations);
+    bench::run_any< bench::mr_any, bench::medium_payload >("medium", iterations);
+    bench::run_any< bench::std_any, bench::large_payload >("large", iterations);
+    bench::run_any< bench::mr_any, bench::large_payload >("large", iterations);
+
+    bench::run_function_pointer(iterations);
+    bench::run_function< std::function< int(int) >, bench::small_payload >("small", iterations);
+    bench::run_function< mr::function< int(int) >, bench::small_payload >("small", iterations);
+    bench::run_function< std::function< int(int) >, bench::medium_payload >("medium", iterations);
+    bench::run_function< mr::function< int(int) >, bench::medium_payload >("medium", iterations);
+    bench::run_function< std::function< int(int) >, bench::large_payload >("large", iterations);
+    bench::run_function< mr::function< int(int) >, bench::large_payload >("large", iterations);
+
+    if (json) {
+        bench::print_json();
+    } else {
+        bench::print_table();
+    }
+}
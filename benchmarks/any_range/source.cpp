@@ -0,0 +1,121 @@
+// Summing ints handed over as an erased range: a virtual iterator interface (two indirect calls per element),
+// mr::any_range iterated element-wise (one indirect call per element) and through next_chunk() (one indirect call
+// per chunk), with a plain loop as the lower bound.
+// Usage: any_range_benchmark [elements] [passes] [chunk]
+
+#include <chrono>
+#include <constexpr_any_range.h>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace bench {
+
+    // The interface erased ranges are passed through today
+    struct int_iterator {
+        virtual ~int_iterator()           = default;
+        virtual bool done() const         = 0;
+        virtual int  current() const      = 0;
+        virtual void advance()            = 0;
+    };
+
+    class vector_iterator final : public int_iterator {
+      public:
+        explicit vector_iterator(const std::vector< int >& values) : it(values.begin()), end(values.end()) {
+        }
+
+        bool done() const override {
+            return it == end;
+        }
+        int current() const override {
+            return *it;
+        }
+        void advance() override {
+            ++it;
+        }
+
+      private:
+        std::vector< int >::const_iterator it;
+        std::vector< int >::const_iterator end;
+    };
+
+    // Defined out of line of the loops below, as the consumer would be in another module
+    [[gnu::noinline]] std::unique_ptr< int_iterator > make_virtual(const std::vector< int >& values) {
+        return std::make_unique< vector_iterator >(values);
+    }
+
+    [[gnu::noinline]] mr::any_range< int > make_erased(const std::vector< int >& values) {
+        return mr::any_range< int > { values };
+    }
+
+    template < class Fn >
+    double run(std::size_t elements, int passes, Fn&& fn) {
+        long long  sum   = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass) {
+            sum += fn();
+        }
+        const auto elapsed = std::chrono::duration< double, std::nano >(std::chrono::steady_clock::now() - start);
+
+        if (sum == 42) {
+            std::puts("unreachable");
+        }
+        return elapsed.count() / (static_cast< double >(elements) * passes);
+    }
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    const std::size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    const int         passes   = argc > 2 ? std::atoi(argv[2]) : 5;
+    const std::size_t chunk    = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 256;
+
+    std::vector< int > values(elements);
+    for (std::size_t i = 0; i < elements; ++i) {
+        values[i] = static_cast< int >(i % 1024);
+    }
+
+    const double loop = bench::run(elements, passes, [&] {
+        long long sum = 0;
+        for (const int value : values) {
+            sum += value;
+        }
+        return sum;
+    });
+
+    const double virtual_iterator = bench::run(elements, passes, [&] {
+        long long sum = 0;
+        for (auto it = bench::make_virtual(values); !it->done(); it->advance()) {
+            sum += it->current();
+        }
+        return sum;
+    });
+
+    const double element_wise = bench::run(elements, passes, [&] {
+        long long sum = 0;
+        for (const int value : bench::make_erased(values)) {
+            sum += value;
+        }
+        return sum;
+    });
+
+    std::vector< int > buffer(chunk);
+    const double       chunked = bench::run(elements, passes, [&] {
+        long long  sum   = 0;
+        auto       range = bench::make_erased(values);
+        auto       it    = range.begin();
+        for (std::size_t count = it.next_chunk(buffer); count != 0; count = it.next_chunk(buffer)) {
+            for (std::size_t i = 0; i < count; ++i) {
+                sum += buffer[i];
+            }
+        }
+        return sum;
+    });
+
+    std::printf("%-36s %10s\n", "variant", "ns/element");
+    std::printf("%-36s %10.3f\n", "inline loop", loop);
+    std::printf("%-36s %10.3f\n", "virtual iterator", virtual_iterator);
+    std::printf("%-36s %10.3f\n", "mr::any_range element-wise", element_wise);
+    std::printf("%-36s %10.3f\n", "mr::any_range next_chunk", chunked);
+}
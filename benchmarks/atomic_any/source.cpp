@@ -0,0 +1,123 @@
+// Read throughput of a read-mostly shared mr::any: mr::atomic_any against an std::shared_mutex guarded mr::any.
+// Usage: atomic_any_benchmark [max_readers] [milliseconds_per_run]
+
+#include <algorithm>
+#include <atomic>
+#include <atomic_any.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+    struct Config {
+        std::uint64_t values[16] {};
+    };
+
+    class mutex_any {
+      public:
+        explicit mutex_any(mr::any value) : value(std::move(value)) {
+        }
+
+        template < class Fn >
+        void read(Fn&& fn) const {
+            std::shared_lock lock { mutex };
+            fn(value);
+        }
+
+        void store(mr::any desired) {
+            std::unique_lock lock { mutex };
+            value = std::move(desired);
+        }
+
+      private:
+        mutable std::shared_mutex mutex;
+        mr::any                   value;
+    };
+
+    class atomic_any {
+      public:
+        explicit atomic_any(mr::any value) : cell(std::move(value)) {
+        }
+
+        template < class Fn >
+        void read(Fn&& fn) const {
+            const auto current = cell.load();
+            fn(*current);
+        }
+
+        void store(mr::any desired) {
+            cell.store(std::move(desired));
+        }
+
+      private:
+        mr::atomic_any cell;
+    };
+
+    // Returns reads per second summed over all readers, one writer replaces the value every 100us
+    template < class Cell >
+    double run(int readers, std::chrono::milliseconds duration) {
+        Cell                cell { mr::any { Config {} } };
+        std::atomic< bool > done { false };
+        std::atomic< bool > start { false };
+
+        std::vector< std::uint64_t > reads(readers);
+        std::vector< std::thread >   threads;
+        for (int i = 0; i < readers; ++i) {
+            threads.emplace_back([&, i] {
+                std::uint64_t count = 0;
+                std::uint64_t sink  = 0;
+                while (!start.load(std::memory_order_acquire)) {
+                }
+                while (!done.load(std::memory_order_relaxed)) {
+                    cell.read([&](const mr::any& value) { sink += mr::any_cast< Config >(&value)->values[i % 16]; });
+                    ++count;
+                }
+                reads[i] = count + (sink & 0); // keep sink alive
+            });
+        }
+
+        std::thread writer { [&] {
+            std::uint64_t version = 0;
+            while (!start.load(std::memory_order_acquire)) {
+            }
+            while (!done.load(std::memory_order_relaxed)) {
+                Config config {};
+                config.values[0] = ++version;
+                cell.store(mr::any { config });
+                std::this_thread::sleep_for(std::chrono::microseconds { 100 });
+            }
+        } };
+
+        start.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(duration);
+        done = true;
+
+        writer.join();
+        std::uint64_t total = 0;
+        for (int i = 0; i < readers; ++i) {
+            threads[i].join();
+            total += reads[i];
+        }
+        return static_cast< double >(total) / std::chrono::duration< double >(duration).count();
+    }
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    const int max_readers =
+        argc > 1 ? std::atoi(argv[1]) : static_cast< int >(std::max(1u, std::thread::hardware_concurrency()));
+    const auto duration = std::chrono::milliseconds { argc > 2 ? std::atoi(argv[2]) : 500 };
+
+    std::printf("%-8s %20s %20s %8s\n", "readers", "shared_mutex reads/s", "atomic_any reads/s", "speedup");
+    for (int readers = 1; readers <= max_readers; readers *= 2) {
+        const double locked   = bench::run< bench::mutex_any >(readers, duration);
+        const double lockfree = bench::run< bench::atomic_any >(readers, duration);
+        std::printf("%-8d %20.0f %20.0f %7.2fx\n", readers, locked, lockfree, lockfree / locked);
+    }
+}
@@ -0,0 +1,73 @@
+// Per element throughput of a float -> float transform: one mr::function call per element against one
+// mr::batch_function call over the whole span, with a plain loop as the lower bound.
+// Usage: batch_function_benchmark [elements] [passes]
+
+#include <chrono>
+#include <constexpr_batch_function.h>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <vector>
+
+namespace bench {
+
+    struct Transform {
+        float operator()(float value) const noexcept {
+            return value * scale + offset;
+        }
+
+        float scale;
+        float offset;
+    };
+
+    template < class Fn >
+    double run(std::size_t elements, int passes, Fn&& fn) {
+        std::vector< float > in(elements);
+        std::vector< float > out(elements);
+        for (std::size_t i = 0; i < elements; ++i) {
+            in[i] = static_cast< float >(i % 1024);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass) {
+            fn(std::span< float > { out }, std::span< const float > { in });
+        }
+        const auto elapsed = std::chrono::duration< double, std::nano >(std::chrono::steady_clock::now() - start);
+
+        if (out[elements / 2] < 0.f) {
+            std::puts("unreachable");
+        }
+        return elapsed.count() / (static_cast< double >(elements) * passes);
+    }
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    const std::size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    const int         passes   = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    const bench::Transform transform { 1.5f, 0.25f };
+
+    const double loop = bench::run(elements, passes, [&](std::span< float > out, std::span< const float > in) {
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            out[i] = transform(in[i]);
+        }
+    });
+
+    const mr::function< float(float) > scalar = transform;
+    const double per_element = bench::run(elements, passes, [&](std::span< float > out, std::span< const float > in) {
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            out[i] = scalar(in[i]);
+        }
+    });
+
+    const mr::batch_function< float(float) > batch = transform;
+    const double batched = bench::run(elements, passes, [&](std::span< float > out, std::span< const float > in) {
+        batch(out, in);
+    });
+
+    std::printf("%-36s %10s\n", "variant", "ns/element");
+    std::printf("%-36s %10.3f\n", "inline loop", loop);
+    std::printf("%-36s %10.3f\n", "mr::function per element", per_element);
+    std::printf("%-36s %10.3f\n", "mr::batch_function per span", batched);
+}
@@ -0,0 +1,68 @@
+// Per connection handler setup in an accept loop: bind a member function to the connection, erase it, call it once
+// and drop it. mr::bind_front into mr::function against a lambda in std::function and std::bind_front in
+// std::function.
+// Usage: bind_benchmark [connections] [passes]
+
+#include <chrono>
+#include <constexpr_function.h>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+namespace bench {
+
+    struct Connection {
+        int Handle(int request) const noexcept {
+            return id + request;
+        }
+
+        int id;
+    };
+
+    template < class Make >
+    double run(std::size_t connections, int passes, Make&& make) {
+        std::vector< Connection > pool(connections);
+        for (std::size_t i = 0; i < connections; ++i) {
+            pool[i].id = static_cast< int >(i);
+        }
+
+        long long  sum   = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass) {
+            for (auto& conn : pool) {
+                auto handler = make(conn);
+                sum += handler(pass);
+            }
+        }
+        const auto elapsed = std::chrono::duration< double, std::nano >(std::chrono::steady_clock::now() - start);
+
+        if (sum == 42) {
+            std::puts("unreachable");
+        }
+        return elapsed.count() / (static_cast< double >(connections) * passes);
+    }
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    const std::size_t connections = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000;
+    const int         passes      = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    const double bound = bench::run(connections, passes, [](const bench::Connection& conn) {
+        return mr::function< int(int) > { mr::bind_front(&bench::Connection::Handle, &conn) };
+    });
+
+    const double lambda = bench::run(connections, passes, [](const bench::Connection& conn) {
+        return std::function< int(int) > { [&conn](int request) { return conn.Handle(request); } };
+    });
+
+    const double std_bound = bench::run(connections, passes, [](const bench::Connection& conn) {
+        return std::function< int(int) > { std::bind_front(&bench::Connection::Handle, &conn) };
+    });
+
+    std::printf("%-40s %12s\n", "variant", "ns/handler");
+    std::printf("%-40s %12.3f\n", "mr::function(mr::bind_front)", bound);
+    std::printf("%-40s %12.3f\n", "std::function(lambda)", lambda);
+    std::printf("%-40s %12.3f\n", "std::function(std::bind_front)", std_bound);
+}
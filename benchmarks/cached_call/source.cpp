@@ -0,0 +1,64 @@
+// Cost of an mr::function call through mr::cached_call at a monomorphic call site and at a site alternating between
+// two candidate types, against the erased call, std::function and a direct call of the callable.
+// Usage: cached_call_benchmark [calls]
+
+#include <chrono>
+#include <constexpr_cached_call.h>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+namespace bench {
+
+    struct Scale {
+        long long operator()(long long value) const noexcept {
+            return value * 3 + 1;
+        }
+    };
+
+    struct Shift {
+        long long operator()(long long value) const noexcept {
+            return (value << 1) - 7;
+        }
+    };
+
+    // fns alternates through the given functions, one call each
+    template < class Fn, std::size_t N, class Call >
+    double run(std::size_t calls, const Fn (&fns)[N], Call&& call) {
+        long long  sum   = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < calls; ++i) {
+            sum += call(fns[i % N], static_cast< long long >(i));
+        }
+        const auto elapsed = std::chrono::duration< double, std::nano >(std::chrono::steady_clock::now() - start);
+        if (sum == 42) {
+            std::puts("unreachable");
+        }
+        return elapsed.count() / static_cast< double >(calls);
+    }
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    const std::size_t calls = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+    using function = mr::function< long long(long long) >;
+    const function                            mono[]     = { bench::Scale {} };
+    const function                            poly[]     = { bench::Scale {}, bench::Shift {} };
+    const std::function< long long(long long) > std_mono[] = { bench::Scale {} };
+    const std::function< long long(long long) > std_poly[] = { bench::Scale {}, bench::Shift {} };
+    const bench::Scale                        direct[]   = { bench::Scale {} };
+
+    auto erased = [](const auto& fn, long long value) { return fn(value); };
+    mr::cached_call< bench::Scale, bench::Shift > site {};
+    auto cached = [&site](const function& fn, long long value) { return site(fn, value); };
+
+    std::printf("%-36s %10s %10s\n", "variant", "1 type", "2 types");
+    std::printf("%-36s %10.3f %10s\n", "direct call", bench::run(calls, direct, erased), "");
+    std::printf("%-36s %10.3f %10.3f\n", "std::function", bench::run(calls, std_mono, erased),
+                bench::run(calls, std_poly, erased));
+    std::printf("%-36s %10.3f %10.3f\n", "mr::function", bench::run(calls, mono, erased),
+                bench::run(calls, poly, erased));
+    std::printf("%-36s %10.3f %10.3f\n", "mr::cached_call< Scale, Shift >", bench::run(calls, mono, cached),
+                bench::run(calls, poly, cached));
+}
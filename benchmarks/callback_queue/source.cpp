@@ -0,0 +1,149 @@
+// Cross-thread callback handoff: mr::spsc_callback_queue and mr::callback_queue against std::function in a
+// std::deque behind a mutex.
+//  - throughput: producers post callbacks as fast as they can, one consumer drains them in batches
+//  - latency: round trip of a callback posted to another thread that posts a reply back
+// Usage: callback_queue_benchmark [callbacks] [round_trips]
+
+#include <atomic>
+#include <callback_queue.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+    // The baseline: std::function queued behind a mutex, drained in batches to keep the lock short
+    class locked_queue {
+      public:
+        explicit locked_queue(std::size_t) {
+        }
+
+        template < class Callable >
+        void push(Callable&& Fn) {
+            std::lock_guard< std::mutex > lock { mutex };
+            queue.emplace_back(std::forward< Callable >(Fn));
+        }
+
+        std::size_t drain(std::size_t max) {
+            {
+                std::lock_guard< std::mutex > lock { mutex };
+                while (batch.size() < max && !queue.empty()) {
+                    batch.push_back(std::move(queue.front()));
+                    queue.pop_front();
+                }
+            }
+            for (auto& fn : batch) {
+                fn();
+            }
+            const std::size_t count = batch.size();
+            batch.clear();
+            return count;
+        }
+
+      private:
+        std::mutex                             mutex {};
+        std::deque< std::function< void() > >  queue {};
+        std::vector< std::function< void() > > batch {};
+    };
+
+    // Drains until count callbacks ran, yielding while the queue is empty
+    template < class Queue >
+    void drain_until(Queue& queue, long long count) {
+        for (long long drained = 0; drained < count;) {
+            const std::size_t ran = queue.drain(64);
+            drained += static_cast< long long >(ran);
+            if (ran == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // Nanoseconds per callback
+    template < class Queue >
+    double throughput(int producers, long long callbacks) {
+        Queue           queue { 1024 };
+        long long       sum        = 0;
+        const long long per_thread = callbacks / producers;
+
+        const auto                 start = std::chrono::steady_clock::now();
+        std::vector< std::thread > threads {};
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&] {
+                // ~40 bytes of state, inline in the mr queues' slots and heap allocated by std::function
+                for (long long i = 0; i < per_thread; ++i) {
+                    queue.push([&sum, i, a = i * 2, b = i * 3, c = i * 5] { sum += i + a + b + c; });
+                }
+            });
+        }
+        drain_until(queue, per_thread * producers);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const auto elapsed = std::chrono::duration< double, std::nano >(std::chrono::steady_clock::now() - start);
+
+        if (sum == 42) {
+            std::puts("unreachable");
+        }
+        return elapsed.count() / static_cast< double >(per_thread * producers);
+    }
+
+    // Mean nanoseconds per round trip
+    template < class Queue >
+    double latency(long long round_trips) {
+        Queue               to_worker { 64 };
+        Queue               to_main { 64 };
+        std::atomic< bool > stop { false };
+
+        std::thread worker { [&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (to_worker.drain(64) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        } };
+
+        const auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < round_trips; ++i) {
+            bool replied = false;
+            to_worker.push([&to_main, &replied] { to_main.push([&replied] { replied = true; }); });
+            while (!replied) {
+                if (to_main.drain(1) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        const auto elapsed = std::chrono::duration< double, std::nano >(std::chrono::steady_clock::now() - start);
+
+        stop.store(true, std::memory_order_relaxed);
+        worker.join();
+        return elapsed.count() / static_cast< double >(round_trips);
+    }
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    const long long callbacks   = argc > 1 ? std::atoll(argv[1]) : 4000000;
+    const long long round_trips = argc > 2 ? std::atoll(argv[2]) : 100000;
+
+    using spsc = mr::spsc_callback_queue< void() >;
+    using mpsc = mr::callback_queue< void() >;
+
+    std::printf("throughput, ns per callback\n");
+    std::printf("%-10s %14s %14s %14s\n", "producers", "spsc", "mpsc", "locked");
+    std::printf("%-10d %14.2f %14.2f %14.2f\n", 1, bench::throughput< spsc >(1, callbacks),
+                bench::throughput< mpsc >(1, callbacks), bench::throughput< bench::locked_queue >(1, callbacks));
+    for (const int producers : { 2, 4 }) {
+        std::printf("%-10d %14s %14.2f %14.2f\n", producers, "-", bench::throughput< mpsc >(producers, callbacks),
+                    bench::throughput< bench::locked_queue >(producers, callbacks));
+    }
+
+    std::printf("\nlatency, ns per round trip\n");
+    std::printf("%-10s %14.2f\n", "spsc", bench::latency< spsc >(round_trips));
+    std::printf("%-10s %14.2f\n", "mpsc", bench::latency< mpsc >(round_trips));
+    std::printf("%-10s %14.2f\n", "locked", bench::latency< bench::locked_queue >(round_trips));
+}
@@ -0,0 +1,230 @@
+// Compile time and peak compiler memory of constant evaluated type erasure as the amount of it grows. For every
+// compiler and size N, translation units with N distinct static_assert'ed mr::any or mr::function operations are
+// generated and compiled, Clang additionally writing a -ftime-trace report next to the object file.
+// With a baseline file, results more than the threshold above it fail the run, a missing baseline is recorded and
+// a baseline that cannot be read or written fails the run.
+// Usage: compile_time_benchmark --compiler <path> [--compiler <path>]... [--sizes 10,100,1000,10000]
+//                               [--include <dir>] [--baseline <file>] [--threshold <percent>] [--update]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/resource.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+namespace bench {
+
+    struct measurement {
+        std::string compiler;
+        std::string kind;
+        std::size_t size;
+        double      seconds;
+        long        peak_rss_kb;
+    };
+
+    // Every operation is a distinct constant evaluation and, for mr::function, a distinct closure type
+    void generate(const std::string& path, std::string_view kind, std::size_t size) {
+        std::ofstream out { path };
+        if (kind == "any") {
+            out << "#include <constexpr_any.h>\n\n";
+            for (std::size_t i = 0; i < size; ++i) {
+                out << "constexpr bool any_" << i << "() {\n"
+                    << "    mr::any value { " << i << " };\n"
+                    << "    mr::any copy { value };\n"
+                    << "    value.reset();\n"
+                    << "    return mr::any_cast< int >(copy) == " << i << ";\n"
+                    << "}\n"
+                    << "static_assert(any_" << i << "());\n";
+            }
+        } else {
+            out << "#include <constexpr_function.h>\n\n";
+            for (std::size_t i = 0; i < size; ++i) {
+                out << "constexpr bool function_" << i << "() {\n"
+                    << "    mr::function< int(int) > fn = [](int x) { return x + " << i << "; };\n"
+                    << "    mr::function< int(int) > copy { fn };\n"
+                    << "    return copy(1) == " << i + 1 << ";\n"
+                    << "}\n"
+                    << "static_assert(function_" << i << "());\n";
+            }
+        }
+    }
+
+    // Runs the compiler and reports its wall time and the peak resident set of it and its subprocesses
+    bool compile(const std::vector< std::string >& command, double& seconds, long& peak_rss_kb) {
+#if defined(__unix__) || defined(__APPLE__)
+        std::vector< char* > argv {};
+        for (const std::string& arg : command) {
+            argv.push_back(const_cast< char* >(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        const auto  start = std::chrono::steady_clock::now();
+        const pid_t pid   = fork();
+        if (pid == 0) {
+            execvp(argv[0], argv.data());
+            _exit(127);
+        }
+        int           status = 0;
+        struct rusage usage {};
+        if (pid < 0 || wait4(pid, &status, 0, &usage) != pid) {
+            return false;
+        }
+        seconds     = std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
+        peak_rss_kb = usage.ru_maxrss;
+    #if defined(__APPLE__)
+        peak_rss_kb /= 1024; // bytes on macOS
+    #endif
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#else
+        (void)command, (void)seconds, (void)peak_rss_kb;
+        std::fprintf(stderr, "compile_time_benchmark needs a POSIX system to measure subprocesses\n");
+        return false;
+#endif
+    }
+
+    // A missing baseline reads as empty, a baseline that cannot be opened or parsed fails
+    bool read_results(const std::string& path, std::vector< measurement >& results) {
+        std::ifstream in { path };
+        if (!in) {
+            std::error_code error {};
+            return !std::filesystem::exists(path, error) && !error;
+        }
+        measurement m {};
+        while (in >> m.compiler >> m.kind >> m.size >> m.seconds >> m.peak_rss_kb) {
+            results.push_back(m);
+        }
+        return in.eof() && !in.bad();
+    }
+
+    bool write_results(const std::string& path, const std::vector< measurement >& results) {
+        std::ofstream out { path };
+        for (const measurement& m : results) {
+            out << m.compiler << ' ' << m.kind << ' ' << m.size << ' ' << m.seconds << ' ' << m.peak_rss_kb << '\n';
+        }
+        out.close();
+        return !out.fail();
+    }
+
+    // Small absolute differences are noise whatever their ratio to the baseline
+    constexpr double min_seconds_regression = 0.25;
+    constexpr long   min_rss_kb_regression  = 16 * 1024;
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    std::vector< std::string > compilers {};
+    std::vector< std::size_t > sizes { 10, 100, 1000, 10000 };
+    std::string                include_dir = MR_INCLUDE_DIR;
+    std::string                baseline {};
+    double                     threshold = 25.;
+    bool                       update    = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg   = argv[i];
+        const char*            value = i + 1 < argc ? argv[i + 1] : "";
+        if (arg == "--compiler") {
+            compilers.emplace_back(value), ++i;
+        } else if (arg == "--sizes") {
+            sizes.clear();
+            std::stringstream list { value };
+            for (std::string size; std::getline(list, size, ',');) {
+                sizes.push_back(std::strtoull(size.c_str(), nullptr, 10));
+            }
+            ++i;
+        } else if (arg == "--include") {
+            include_dir = value, ++i;
+        } else if (arg == "--baseline") {
+            baseline = value, ++i;
+        } else if (arg == "--threshold") {
+            threshold = std::strtod(value, nullptr), ++i;
+        } else if (arg == "--update") {
+            update = true;
+        } else {
+            std::fprintf(stderr, "unknown argument %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (compilers.empty()) {
+        std::fprintf(stderr, "at least one --compiler is required\n");
+        return 2;
+    }
+
+    std::vector< bench::measurement > results {};
+    std::printf("%-24s %-9s %7s %10s %14s\n", "compiler", "kind", "N", "seconds", "peak RSS (MB)");
+    for (std::size_t c = 0; c < compilers.size(); ++c) {
+        const std::string& compiler = compilers[c];
+        const bool         clang    = compiler.find("clang") != std::string::npos;
+        const std::string  name     = compiler.substr(compiler.find_last_of('/') + 1);
+        for (const std::string_view kind : { "any", "function" }) {
+            for (const std::size_t size : sizes) {
+                const std::string stem = "compile_time_" + std::to_string(c) + "_" + std::string { kind } + "_" +
+                                         std::to_string(size);
+                bench::generate(stem + ".cpp", kind, size);
+
+                std::vector< std::string > command { compiler, "-std=c++20",  "-O0", "-I",       include_dir,
+                                                     "-c",     stem + ".cpp", "-o",  stem + ".o" };
+                if (clang) {
+                    command.push_back("-ftime-trace");
+                }
+
+                bench::measurement m { name, std::string { kind }, size, 0., 0 };
+                if (!bench::compile(command, m.seconds, m.peak_rss_kb)) {
+                    std::fprintf(stderr, "%s failed to compile %s.cpp\n", compiler.c_str(), stem.c_str());
+                    return 1;
+                }
+                std::printf("%-24s %-9s %7zu %10.3f %14.1f\n", m.compiler.c_str(), m.kind.c_str(), m.size, m.seconds,
+                            static_cast< double >(m.peak_rss_kb) / 1024.);
+                results.push_back(m);
+            }
+        }
+    }
+
+    if (baseline.empty()) {
+        return 0;
+    }
+    std::vector< bench::measurement > previous {};
+    if (!update && !bench::read_results(baseline, previous)) {
+        std::fprintf(stderr, "failed to read the baseline %s\n", baseline.c_str());
+        return 1;
+    }
+    if (previous.empty() || update) {
+        if (!bench::write_results(baseline, results)) {
+            std::fprintf(stderr, "failed to write the baseline %s\n", baseline.c_str());
+            return 1;
+        }
+        std::printf("baseline recorded in %s\n", baseline.c_str());
+        return 0;
+    }
+
+    int regressions = 0;
+    for (const bench::measurement& m : results) {
+        for (const bench::measurement& p : previous) {
+            if (p.compiler != m.compiler || p.kind != m.kind || p.size != m.size) {
+                continue;
+            }
+            const double limit = 1. + threshold / 100.;
+            if (m.seconds > p.seconds * limit && m.seconds - p.seconds > bench::min_seconds_regression) {
+                std::printf("REGRESSION %s %s N=%zu: %.3f s against %.3f s\n", m.compiler.c_str(), m.kind.c_str(),
+                            m.size, m.seconds, p.seconds);
+                ++regressions;
+            }
+            if (m.peak_rss_kb > p.peak_rss_kb * limit && m.peak_rss_kb - p.peak_rss_kb > bench::min_rss_kb_regression) {
+                std::printf("REGRESSION %s %s N=%zu: %ld KB against %ld KB peak RSS\n", m.compiler.c_str(),
+                            m.kind.c_str(), m.size, m.peak_rss_kb, p.peak_rss_kb);
+                ++regressions;
+            }
+        }
+    }
+    return regressions == 0 ? 0 : 1;
+}
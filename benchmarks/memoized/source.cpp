@@ -0,0 +1,53 @@
+// A hot pure lookup called through mr::function directly, through mr::memoized without a run-time cache (the
+// lookup overhead alone) and through mr::memoized with its thread-local cache, over a small set of repeating keys.
+// Usage: memoized_benchmark [calls] [keys]
+
+#include <chrono>
+#include <constexpr_memoized.h>
+#include <cstdio>
+#include <cstdlib>
+
+namespace bench {
+
+    // Stands in for a pure helper of moderate cost
+    constexpr int collatz_steps(long long n) {
+        int steps = 0;
+        for (; n != 1; ++steps) {
+            n = n % 2 == 0 ? n / 2 : 3 * n + 1;
+        }
+        return steps;
+    }
+
+    template < class Fn >
+    double run(std::size_t calls, std::size_t keys, const Fn& fn) {
+        long long  sum   = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < calls; ++i) {
+            sum += fn(static_cast< long long >(27 + i % keys));
+        }
+        const auto elapsed = std::chrono::duration< double, std::nano >(std::chrono::steady_clock::now() - start);
+        if (sum == 42) {
+            std::puts("unreachable");
+        }
+        return elapsed.count() / static_cast< double >(calls);
+    }
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    const std::size_t calls = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    const std::size_t keys  = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+
+    const mr::function< int(long long) >                       direct = bench::collatz_steps;
+    const mr::memoized< int(long long), mr::no_runtime_cache > uncached { bench::collatz_steps };
+    const mr::memoized< int(long long) >                       cached { bench::collatz_steps };
+
+    const double direct_ns   = bench::run(calls, keys, direct);
+    const double uncached_ns = bench::run(calls, keys, uncached);
+    const double cached_ns   = bench::run(calls, keys, cached);
+
+    std::printf("%-40s %10s\n", "variant", "ns/call");
+    std::printf("%-40s %10.3f\n", "mr::function", direct_ns);
+    std::printf("%-40s %10.3f\n", "mr::memoized, no_runtime_cache", uncached_ns);
+    std::printf("%-40s %10.3f\n", "mr::memoized, thread_local_cache<>", cached_ns);
+}
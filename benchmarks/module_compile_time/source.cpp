@@ -0,0 +1,145 @@
+// Compile time of a project whose translation units all use mr::any and mr::function, once including the headers and
+// once importing the mr.type_erasure module. The module variant includes building the module interface itself.
+// Translation units are compiled one after the other, the totals are the sum of their wall times. GCC only.
+// Usage: module_compile_time_benchmark [--compiler <path>] [--units 200] [--include <dir>] [--opt -O2]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+namespace bench {
+
+    // An ordinary unit of the project: a handler erased into mr::function, a value read back from mr::any, and one
+    // constant evaluated check
+    void generate(const std::string& path, bool module, std::size_t index) {
+        std::ofstream out { path };
+        if (module) {
+            // GCC 12 does not find these declarations through the module when instantiating its templates
+            out << "#include <new>\n#include <optional>\n#include <tuple>\n#include <typeinfo>\n\n"
+                << "import mr.type_erasure;\n\n";
+        } else {
+            out << "#include <constexpr_any.h>\n#include <constexpr_function.h>\n\n";
+        }
+        out << "namespace unit_" << index << " {\n"
+            << "    struct Handler {\n"
+            << "        constexpr int operator()(int x) const { return x + " << index << "; }\n"
+            << "    };\n"
+            << "    static_assert(mr::function< int(int) > { Handler {} }(1) == " << index + 1 << ");\n"
+            << "}\n"
+            << "mr::function< int(int) > make_handler_" << index << "() { return unit_" << index
+            << "::Handler {}; }\n"
+            << "int read_" << index << "(const mr::any& value) {\n"
+            << "    if (auto v = mr::try_any_cast< int >(value)) { return *v; }\n"
+            << "    return make_handler_" << index << "()(0);\n"
+            << "}\n";
+    }
+
+    // Runs the compiler and returns its wall time, a negative time when it failed
+    double compile(const std::vector< std::string >& command) {
+#if defined(__unix__) || defined(__APPLE__)
+        std::vector< char* > argv {};
+        for (const std::string& arg : command) {
+            argv.push_back(const_cast< char* >(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        const auto  start = std::chrono::steady_clock::now();
+        const pid_t pid   = fork();
+        if (pid == 0) {
+            execvp(argv[0], argv.data());
+            _exit(127);
+        }
+        int status = 0;
+        if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            return -1.;
+        }
+        return std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
+#else
+        (void)command;
+        std::fprintf(stderr, "module_compile_time_benchmark needs a POSIX system to run the compiler\n");
+        return -1.;
+#endif
+    }
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    std::string compiler    = MR_CXX_COMPILER;
+    std::size_t units       = 200;
+    std::string include_dir = MR_INCLUDE_DIR;
+    std::string opt         = "-O2";
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg   = argv[i];
+        const char*            value = i + 1 < argc ? argv[i + 1] : "";
+        if (arg == "--compiler") {
+            compiler = value, ++i;
+        } else if (arg == "--units") {
+            units = std::strtoull(value, nullptr, 10), ++i;
+        } else if (arg == "--include") {
+            include_dir = value, ++i;
+        } else if (arg == "--opt") {
+            opt = value, ++i;
+        } else {
+            std::fprintf(stderr, "unknown argument %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (compiler.find("clang") != std::string::npos) {
+        std::fprintf(stderr, "only GCC builds the mr.type_erasure module\n");
+        return 2;
+    }
+
+    const std::string mapper = "module_compile_time.mapper";
+    std::ofstream { mapper } << "mr.type_erasure module_compile_time.gcm\n";
+    const std::vector< std::string > base { compiler, "-std=c++20", opt, "-I", include_dir };
+
+    auto with = [&base](std::initializer_list< std::string > args) {
+        std::vector< std::string > command = base;
+        command.insert(command.end(), args);
+        return command;
+    };
+
+    const double module_build = bench::compile(with({ "-fmodules-ts", "-fmodule-mapper=" + mapper, "-x", "c++", "-c",
+                                                      include_dir + "/type_erasure.cppm", "-o", "type_erasure.o" }));
+    if (module_build < 0.) {
+        std::fprintf(stderr, "%s failed to build the module\n", compiler.c_str());
+        return 1;
+    }
+
+    double headers = 0., imports = 0.;
+    for (std::size_t i = 0; i < units; ++i) {
+        const std::string header_unit = "header_unit_" + std::to_string(i) + ".cpp";
+        const std::string module_unit = "module_unit_" + std::to_string(i) + ".cpp";
+        bench::generate(header_unit, false, i);
+        bench::generate(module_unit, true, i);
+
+        const double header_time = bench::compile(with({ "-c", header_unit, "-o", header_unit + ".o" }));
+        const double module_time = bench::compile(
+            with({ "-fmodules-ts", "-fmodule-mapper=" + mapper, "-c", module_unit, "-o", module_unit + ".o" }));
+        if (header_time < 0. || module_time < 0.) {
+            std::fprintf(stderr, "%s failed to compile unit %zu\n", compiler.c_str(), i);
+            return 1;
+        }
+        headers += header_time;
+        imports += module_time;
+    }
+
+    const double unit_count = static_cast< double >(units);
+    std::printf("%-28s %8s %12s %12s\n", "variant", "units", "total (s)", "per unit (s)");
+    std::printf("%-28s %8zu %12.3f %12.4f\n", "#include headers", units, headers, headers / unit_count);
+    std::printf("%-28s %8zu %12.3f %12.4f\n", "import mr.type_erasure", units, module_build + imports,
+                imports / unit_count);
+    std::printf("%-28s %8s %12.3f\n", "  of which module build", "", module_build);
+    std::printf("%-28s %8s %11.2fx\n", "speedup", "", headers / (module_build + imports));
+}
@@ -0,0 +1,58 @@
+// Fan-out: one handler capturing ~200 bytes of state copied into many subscriber lists. mr::function deep copies
+// the callable on every copy, mr::shared_function only bumps a reference count.
+// Usage: shared_function_benchmark [subscribers] [passes]
+
+#include <array>
+#include <chrono>
+#include <constexpr_shared_function.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace bench {
+
+    struct Handler {
+        int operator()(int index) const noexcept {
+            return state[static_cast< std::size_t >(index) % state.size()];
+        }
+
+        std::array< int, 50 > state {};
+    };
+
+    template < class Fn >
+    double run(std::size_t subscribers, int passes) {
+        const Fn source = Handler {};
+
+        std::vector< Fn > lists {};
+        lists.reserve(subscribers);
+
+        long long  sum   = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass) {
+            for (std::size_t i = 0; i < subscribers; ++i) {
+                lists.push_back(source);
+            }
+            sum += lists.back()(pass);
+            lists.clear();
+        }
+        const auto elapsed = std::chrono::duration< double, std::nano >(std::chrono::steady_clock::now() - start);
+
+        if (sum == 42) {
+            std::puts("unreachable");
+        }
+        return elapsed.count() / (static_cast< double >(subscribers) * passes);
+    }
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    const std::size_t subscribers = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500;
+    const int         passes      = argc > 2 ? std::atoi(argv[2]) : 2000;
+
+    std::printf("%-48s %10s\n", "variant", "ns/copy");
+    std::printf("%-48s %10.3f\n", "mr::function", bench::run< mr::function< int(int) > >(subscribers, passes));
+    std::printf("%-48s %10.3f\n", "mr::shared_function<local_refcount>",
+                bench::run< mr::shared_function< int(int), mr::local_refcount > >(subscribers, passes));
+    std::printf("%-48s %10.3f\n", "mr::shared_function<atomic_refcount>",
+                bench::run< mr::shared_function< int(int), mr::atomic_refcount > >(subscribers, passes));
+}
@@ -0,0 +1,159 @@
+// Scaling of mr::task_pool from 1 to N worker threads on two workloads:
+//  - spawn: a binary tree of tasks submitted from inside the pool, balanced by stealing
+//  - inject: batches of independent tasks submitted from outside, against a std::function queue behind a mutex
+// Usage: task_pool_benchmark [max_threads] [depth]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <task_pool.h>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+    inline void work(std::atomic< long long >& sink, int seed) {
+        long long value = seed;
+        for (int i = 0; i < 64; ++i) {
+            value = value * 6364136223846793005ll + 1442695040888963407ll;
+        }
+        sink.fetch_add(value & 1, std::memory_order_relaxed);
+    }
+
+    void spawn(mr::task_pool& pool, std::atomic< long long >& sink, int depth) {
+        if (depth == 0) {
+            work(sink, depth);
+            return;
+        }
+        pool.submit([&pool, &sink, depth] { spawn(pool, sink, depth - 1); });
+        pool.submit([&pool, &sink, depth] { spawn(pool, sink, depth - 1); });
+    }
+
+    // The baseline the pool replaces: one locked queue of std::function
+    class locked_pool {
+      public:
+        explicit locked_pool(std::size_t threads) {
+            for (std::size_t i = 0; i < threads; ++i) {
+                workers.emplace_back([this] { run(); });
+            }
+        }
+
+        ~locked_pool() {
+            {
+                std::lock_guard< std::mutex > lock { mutex };
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        void submit(std::function< void() > fn) {
+            {
+                std::lock_guard< std::mutex > lock { mutex };
+                queue.push_back(std::move(fn));
+            }
+            wake.notify_one();
+        }
+
+      private:
+        void run() {
+            for (;;) {
+                std::function< void() > fn;
+                {
+                    std::unique_lock< std::mutex > lock { mutex };
+                    wake.wait(lock, [this] { return stopping || !queue.empty(); });
+                    if (queue.empty()) {
+                        return;
+                    }
+                    fn = std::move(queue.front());
+                    queue.pop_front();
+                }
+                fn();
+            }
+        }
+
+        std::mutex                            mutex {};
+        std::condition_variable               wake {};
+        std::deque< std::function< void() > > queue {};
+        bool                                  stopping { false };
+        std::vector< std::thread >            workers {};
+    };
+
+    template < class Fn >
+    double seconds(Fn&& fn) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
+    }
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    const std::size_t hardware    = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : hardware;
+    const int         depth       = argc > 2 ? std::atoi(argv[2]) : 18;
+    const double      tasks       = static_cast< double >((1ll << (depth + 1)) - 1);
+
+    std::vector< std::size_t > counts {};
+    for (std::size_t threads = 1; threads < max_threads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(max_threads);
+
+    std::atomic< long long > sink { 0 };
+
+    std::printf("%-8s %16s %16s %16s\n", "threads", "spawn Mtask/s", "inject Mtask/s", "locked Mtask/s");
+    for (const std::size_t threads : counts) {
+        double spawn = 0;
+        double inject = 0;
+        double locked = 0;
+        {
+            mr::task_pool pool { threads };
+            spawn = bench::seconds([&] {
+                pool.submit([&pool, &sink, depth] { bench::spawn(pool, sink, depth); });
+                pool.wait_idle();
+            });
+        }
+        {
+            mr::task_pool pool { threads };
+            inject = bench::seconds([&] {
+                std::vector< mr::task > batch {};
+                for (long long i = 0; i < static_cast< long long >(tasks); ++i) {
+                    batch.emplace_back([&sink, i] { bench::work(sink, static_cast< int >(i)); });
+                    if (batch.size() == 256) {
+                        pool.submit_batch(batch);
+                        batch.clear();
+                    }
+                }
+                pool.submit_batch(batch);
+                pool.wait_idle();
+            });
+        }
+        {
+            std::atomic< long long > done { 0 };
+            locked = bench::seconds([&] {
+                bench::locked_pool pool { threads };
+                for (long long i = 0; i < static_cast< long long >(tasks); ++i) {
+                    pool.submit([&sink, &done, i] {
+                        bench::work(sink, static_cast< int >(i));
+                        done.fetch_add(1, std::memory_order_relaxed);
+                    });
+                }
+            });
+        }
+        std::printf("%-8zu %16.2f %16.2f %16.2f\n", threads, tasks / spawn / 1e6, tasks / inject / 1e6,
+                    tasks / locked / 1e6);
+    }
+
+    if (sink.load() == -1) {
+        std::puts("unreachable");
+    }
+}
@@ -0,0 +1,49 @@
+// Stand-in for a plugin-heavy binary: many distinct callable types of a few layouts erased into mr::function,
+// copied, moved and called. Built once per thunk mode, thunk_size_report compares the symbols of both.
+
+#include <array>
+#include <constexpr_function.h>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace plugins {
+
+    template < int I >
+    struct Handler {
+        int operator()(int x) const {
+            return x * (I + 1) + offset;
+        }
+
+        int offset;
+    };
+
+    template < int I >
+    struct Filter {
+        int operator()(int x) const {
+            return x > values[I % 8] ? x - I : x + I;
+        }
+
+        std::array< int, 8 > values;
+    };
+
+    template < int... I >
+    std::vector< mr::function< int(int) > > make(std::integer_sequence< int, I... >) {
+        std::vector< mr::function< int(int) > > all {};
+        (all.push_back(Handler< I > { I }), ...);
+        (all.push_back(Filter< I > { { I, I, I, I, I, I, I, I } }), ...);
+        return all;
+    }
+
+} // namespace plugins
+
+int main(int argc, char**) {
+    std::vector< mr::function< int(int) > > all    = plugins::make(std::make_integer_sequence< int, 64 >());
+    std::vector< mr::function< int(int) > > copies = all;
+
+    long long sum = 0;
+    for (const auto& fn : copies) {
+        sum += fn(argc);
+    }
+    std::printf("%lld\n", sum);
+}
@@ -0,0 +1,119 @@
+// Size of the mr::function thunks in binaries built from thunk_size/plugins.cpp, per instantiation with --verbose,
+// grouped by thunk kind: copy, move and destroy (Do_op), call (Do_call), type identity (GetTypeID, Type_id) and the
+// remaining mr:: symbols. Symbol sizes are read with nm.
+// Usage: thunk_size_report [--nm <path>] [--verbose] <binary>...
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+    #define popen  _popen
+    #define pclose _pclose
+#endif
+
+namespace bench {
+
+    struct symbol {
+        std::string   name;
+        unsigned long size;
+    };
+
+    // Defined mr:: symbols of binary with their sizes
+    std::vector< symbol > read_symbols(const std::string& nm, const std::string& binary) {
+        std::vector< symbol > symbols {};
+        const std::string     command = nm + " -C -S --size-sort \"" + binary + "\"";
+        std::FILE*            pipe    = popen(command.c_str(), "r");
+        if (!pipe) {
+            return symbols;
+        }
+        char line[8192];
+        while (std::fgets(line, sizeof(line), pipe)) {
+            // address size type name
+            char*               end  = nullptr;
+            (void)std::strtoul(line, &end, 16);
+            const unsigned long size = std::strtoul(end, &end, 16);
+            std::string_view    rest { end };
+            if (rest.size() < 3) {
+                continue;
+            }
+            std::string name { rest.substr(3) };
+            while (!name.empty() && (name.back() == '\n' || name.back() == '\r')) {
+                name.pop_back();
+            }
+            if (name.find("mr::") != std::string::npos) {
+                symbols.push_back(symbol { std::move(name), size });
+            }
+        }
+        pclose(pipe);
+        return symbols;
+    }
+
+    std::string_view kind_of(std::string_view name) {
+        if (name.find("::Do_op<") != std::string_view::npos) {
+            return "Do_op";
+        }
+        if (name.find("::Do_call<") != std::string_view::npos ||
+            name.find("::Do_empty_call") != std::string_view::npos) {
+            return "Do_call";
+        }
+        if (name.find("::GetTypeID<") != std::string_view::npos || name.find("::Type_id") != std::string_view::npos) {
+            return "type identity";
+        }
+        return "other";
+    }
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    std::string                nm      = "nm";
+    bool                       verbose = false;
+    std::vector< std::string > binaries {};
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--nm" && i + 1 < argc) {
+            nm = argv[++i];
+        } else if (arg == "--verbose") {
+            verbose = true;
+        } else {
+            binaries.emplace_back(arg);
+        }
+    }
+    if (binaries.empty()) {
+        std::fprintf(stderr, "at least one binary is required\n");
+        return 2;
+    }
+
+    for (const std::string& binary : binaries) {
+        const std::vector< bench::symbol > symbols = bench::read_symbols(nm, binary);
+        if (symbols.empty()) {
+            std::fprintf(stderr, "no mr:: symbols found in %s\n", binary.c_str());
+            return 1;
+        }
+
+        struct total {
+            unsigned long bytes;
+            unsigned long count;
+        };
+        std::map< std::string_view, total > totals {};
+        unsigned long                       all = 0;
+        std::printf("%s\n", binary.c_str());
+        for (const bench::symbol& s : symbols) {
+            total& t = totals[bench::kind_of(s.name)];
+            t.bytes += s.size;
+            ++t.count;
+            all += s.size;
+            if (verbose) {
+                std::printf("  %8lu  %s\n", s.size, s.name.c_str());
+            }
+        }
+        std::printf("  %-16s %10s %10s\n", "kind", "symbols", "bytes");
+        for (const auto& [kind, t] : totals) {
+            std::printf("  %-16.*s %10lu %10lu\n", static_cast< int >(kind.size()), kind.data(), t.count, t.bytes);
+        }
+        std::printf("  %-16s %10zu %10lu\n\n", "total", symbols.size(), all);
+    }
+}
@@ -0,0 +1,56 @@
+// Cost of tracing an mr::function call with mr::sampled_latency, sampling one call in 64 and every call, with the
+// time stamp counter and steady_clock, against the untraced call. The latency histograms are printed at the end.
+// Usage: traced_function_benchmark [calls]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <traced_function.h>
+
+namespace bench {
+
+    struct Handler {
+        long long operator()(long long value) const noexcept {
+            return value * 3 + 1;
+        }
+    };
+
+    template < class Fn >
+    double run(std::size_t calls, const Fn& fn) {
+        long long  sum   = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < calls; ++i) {
+            sum += fn(static_cast< long long >(i));
+        }
+        const auto elapsed = std::chrono::duration< double, std::nano >(std::chrono::steady_clock::now() - start);
+        if (sum == 42) {
+            std::puts("unreachable");
+        }
+        return elapsed.count() / static_cast< double >(calls);
+    }
+
+    template < std::uint32_t N, class Clock >
+    using traced = mr::traced_function< long long(long long), mr::sampled_latency< N, Clock > >;
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    const std::size_t calls = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+    const mr::function< long long(long long) >         plain      = bench::Handler {};
+    const bench::traced< 64, mr::tsc_clock_source >    tsc_64     = bench::Handler {};
+    const bench::traced< 64, mr::steady_clock_source > steady_64  = bench::Handler {};
+    const bench::traced< 1, mr::tsc_clock_source >     tsc_all    = bench::Handler {};
+    const bench::traced< 1, mr::steady_clock_source >  steady_all = bench::Handler {};
+
+    std::printf("%-40s %10s\n", "variant", "ns/call");
+    std::printf("%-40s %10.3f\n", "mr::function", bench::run(calls, plain));
+    std::printf("%-40s %10.3f\n", "sampled_latency<64, tsc_clock_source>", bench::run(calls, tsc_64));
+    std::printf("%-40s %10.3f\n", "sampled_latency<64, steady_clock_source>", bench::run(calls, steady_64));
+    std::printf("%-40s %10.3f\n", "sampled_latency<1, tsc_clock_source>", bench::run(calls, tsc_all));
+    std::printf("%-40s %10.3f\n", "sampled_latency<1, steady_clock_source>", bench::run(calls, steady_all));
+
+    std::printf("\n");
+    mr::sampled_latency< 64, mr::tsc_clock_source >::dump(stdout);
+    mr::sampled_latency< 1, mr::steady_clock_source >::dump(stdout);
+}
@@ -0,0 +1,90 @@
+// Lookup-heavy component bag: mr::type_map against std::unordered_map< std::type_index, mr::any >.
+// Usage: type_map_benchmark [entities] [passes]
+
+#include <chrono>
+#include <constexpr_type_map.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+    template < int I >
+    struct Component {
+        std::uint64_t value = I;
+    };
+
+    struct unordered_bag {
+        template < class T >
+        void emplace() {
+            values.emplace(std::type_index { typeid(T) }, mr::any { T {} });
+        }
+
+        template < class T >
+        const T* get() const {
+            auto it = values.find(std::type_index { typeid(T) });
+            return it == values.end() ? nullptr : mr::any_cast< T >(std::addressof(it->second));
+        }
+
+        std::unordered_map< std::type_index, mr::any > values;
+    };
+
+    struct type_map_bag {
+        template < class T >
+        void emplace() {
+            values.emplace< T >();
+        }
+
+        template < class T >
+        const T* get() const {
+            return values.get< T >();
+        }
+
+        mr::type_map values;
+    };
+
+    // Every entity holds the even components, lookups alternate between present and absent types
+    template < class Bag, int... Is >
+    double run(std::size_t entities, int passes, std::integer_sequence< int, Is... >) {
+        std::vector< Bag > bags(entities);
+        for (auto& bag : bags) {
+            ((Is % 2 == 0 ? bag.template emplace< Component< Is > >() : void()), ...);
+        }
+
+        std::uint64_t sum   = 0;
+        const auto    start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass) {
+            for (const auto& bag : bags) {
+                ((sum += [&] {
+                     const auto* component = bag.template get< Component< Is > >();
+                     return component ? component->value : 1;
+                 }()),
+                 ...);
+            }
+        }
+        const auto elapsed = std::chrono::duration< double, std::nano >(std::chrono::steady_clock::now() - start);
+
+        if (sum == 0) {
+            std::puts("unreachable");
+        }
+        return elapsed.count() / (static_cast< double >(entities) * passes * sizeof...(Is));
+    }
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    const std::size_t entities = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000;
+    const int         passes   = argc > 2 ? std::atoi(argv[2]) : 50;
+    const auto        types    = std::make_integer_sequence< int, 16 > {};
+
+    const double unordered = bench::run< bench::unordered_bag >(entities, passes, types);
+    const double flat      = bench::run< bench::type_map_bag >(entities, passes, types);
+
+    std::printf("%-40s %10s\n", "container", "ns/lookup");
+    std::printf("%-40s %10.2f\n", "unordered_map<type_index, mr::any>", unordered);
+    std::printf("%-40s %10.2f\n", "mr::type_map", flat);
+}
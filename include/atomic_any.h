@@ -0,0 +1,247 @@
+#if !defined(ATOMIC_ANY_H_INCLUDED_ED9074E3_4B96_4DAE_B34A_747B767C589F)
+    #define ATOMIC_ANY_H_INCLUDED_ED9074E3_4B96_4DAE_B34A_747B767C589F
+
+// Read-mostly shared values: readers take an immutable snapshot without locking, writers publish a new value and the
+// old one is reclaimed once its last snapshot is released.
+//
+// The current node is kept in a single word together with a count of loads in flight (split reference counting).
+// A load announces itself with one fetch_add on that word, pins the node through the node's own reference count and
+// then hands the announcement back, either to the word or, if a writer swapped the node out meanwhile, to the node.
+// Nodes are never re-installed, so a pinned node address cannot be reused while a load is in progress.
+
+    #include <atomic>
+    #include <constexpr_any.h>
+    #include <cstddef>
+    #include <cstdint>
+    #include <type_traits>
+    #include <utility>
+
+namespace mr {
+
+    template < class T >
+    class snapshot;
+
+    template < class T >
+    class atomic_snapshot;
+
+    namespace detail {
+
+        template < class T >
+        struct atomic_snapshot_node {
+            template < class... Args >
+            explicit atomic_snapshot_node(Args&&... args) : value(std::forward< Args >(args)...) {
+            }
+
+            void acquire() noexcept {
+                refs.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void release(std::ptrdiff_t count = 1) noexcept {
+                if (refs.fetch_sub(count, std::memory_order_acq_rel) == count) {
+                    delete this;
+                }
+            }
+
+            const T                       value;
+            std::atomic< std::ptrdiff_t > refs { 1 };
+        };
+
+        // Pointer in the low 48 bits, loads in flight in the high 16 bits.
+        struct atomic_snapshot_word {
+            static_assert(sizeof(void*) == sizeof(std::uint64_t), "mr::atomic_snapshot requires 64-bit pointers");
+
+            using value_type = std::uint64_t;
+
+            static constexpr value_type Count_shift = 48;
+            static constexpr value_type Count_one   = value_type { 1 } << Count_shift;
+            static constexpr value_type Ptr_mask    = Count_one - 1;
+
+            template < class Node >
+            static value_type pack(Node* ptr) noexcept {
+                return static_cast< value_type >(reinterpret_cast< std::uintptr_t >(ptr));
+            }
+
+            template < class Node >
+            static Node* pointer(value_type word) noexcept {
+                return reinterpret_cast< Node* >(static_cast< std::uintptr_t >(word & Ptr_mask));
+            }
+
+            static std::ptrdiff_t count(value_type word) noexcept {
+                return static_cast< std::ptrdiff_t >(word >> Count_shift);
+            }
+        };
+
+    } // namespace detail
+
+    // Shared, immutable view of a value published through mr::atomic_snapshot.
+    template < class T >
+    class [[nodiscard]] snapshot {
+        using Node = detail::atomic_snapshot_node< T >;
+
+      public:
+        snapshot() noexcept = default;
+
+        snapshot(const snapshot& rhs) noexcept : node(rhs.node) {
+            if (node) {
+                node->acquire();
+            }
+        }
+
+        snapshot(snapshot&& rhs) noexcept : node(std::exchange(rhs.node, nullptr)) {
+        }
+
+        ~snapshot() {
+            reset();
+        }
+
+        snapshot& operator=(const snapshot& rhs) noexcept {
+            if (std::addressof(rhs) != this) {
+                snapshot(rhs).swap(*this);
+            }
+            return *this;
+        }
+
+        snapshot& operator=(snapshot&& rhs) noexcept {
+            if (std::addressof(rhs) != this) {
+                reset();
+                node = std::exchange(rhs.node, nullptr);
+            }
+            return *this;
+        }
+
+        void reset() noexcept {
+            if (node) {
+                std::exchange(node, nullptr)->release();
+            }
+        }
+
+        void swap(snapshot& rhs) noexcept {
+            std::swap(node, rhs.node);
+        }
+
+        [[nodiscard]] const T* get() const noexcept {
+            return node ? std::addressof(node->value) : nullptr;
+        }
+
+        [[nodiscard]] const T& operator*() const noexcept {
+            return node->value;
+        }
+
+        [[nodiscard]] const T* operator->() const noexcept {
+            return get();
+        }
+
+        explicit operator bool() const noexcept {
+            return node != nullptr;
+        }
+
+        // Two snapshots are equal when they observe the same store.
+        [[nodiscard]] friend bool operator==(const snapshot& lhs, const snapshot& rhs) noexcept {
+            return lhs.node == rhs.node;
+        }
+
+      private:
+        friend class atomic_snapshot< T >;
+
+        // Adopts one reference of ptr
+        explicit snapshot(Node* ptr) noexcept : node(ptr) {
+        }
+
+        Node* node { nullptr };
+    };
+
+    // Lock-free cell holding the latest published T. Readers never block writers and vice versa; a value replaced by
+    // store/exchange/compare_exchange is destroyed when the cell and every snapshot of it have let go.
+    template < class T >
+    class atomic_snapshot {
+        using Node = detail::atomic_snapshot_node< T >;
+        using Word = detail::atomic_snapshot_word;
+
+      public:
+        using value_type    = T;
+        using snapshot_type = snapshot< T >;
+
+        atomic_snapshot() : atomic_snapshot(T {}) {
+        }
+
+        explicit atomic_snapshot(T value) : word(Word::pack(new Node(std::move(value)))) {
+        }
+
+        atomic_snapshot(const atomic_snapshot&)            = delete;
+        atomic_snapshot& operator=(const atomic_snapshot&) = delete;
+
+        ~atomic_snapshot() {
+            retire(word.load(std::memory_order_acquire));
+        }
+
+        [[nodiscard]] snapshot_type load() const noexcept {
+            return snapshot_type { acquire() };
+        }
+
+        void store(T desired) {
+            retire(word.exchange(Word::pack(new Node(std::move(desired))), std::memory_order_acq_rel));
+        }
+
+        [[nodiscard]] snapshot_type exchange(T desired) {
+            const auto old = word.exchange(Word::pack(new Node(std::move(desired))), std::memory_order_acq_rel);
+            // The cell's own reference is handed over to the returned snapshot
+            auto* node = Word::pointer< Node >(old);
+            if (const auto in_flight = Word::count(old); in_flight != 0) {
+                node->refs.fetch_add(in_flight, std::memory_order_relaxed);
+            }
+            return snapshot_type { node };
+        }
+
+        // Publishes desired if the cell still holds the value observed by expected, otherwise reloads expected.
+        bool compare_exchange(snapshot_type& expected, T desired) {
+            Node* const node    = new Node(std::move(desired));
+            auto        current = word.load(std::memory_order_relaxed);
+            while (Word::pointer< Node >(current) == expected.node) {
+                // Loads in flight only change the count bits, retry until the pointer itself differs
+                if (word.compare_exchange_weak(current, Word::pack(node), std::memory_order_acq_rel,
+                                               std::memory_order_relaxed)) {
+                    retire(current);
+                    return true;
+                }
+            }
+            delete node;
+            expected = load();
+            return false;
+        }
+
+        [[nodiscard]] static constexpr bool is_always_lock_free() noexcept {
+            return std::atomic< Word::value_type >::is_always_lock_free;
+        }
+
+      private:
+        Node* acquire() const noexcept {
+            auto  current = word.fetch_add(Word::Count_one, std::memory_order_acquire) + Word::Count_one;
+            Node* node    = Word::pointer< Node >(current);
+            node->acquire();
+
+            while (true) {
+                if (Word::pointer< Node >(current) != node) {
+                    // A writer swapped the node out and moved our in-flight count onto the node itself
+                    node->release();
+                    break;
+                }
+                if (word.compare_exchange_weak(current, current - Word::Count_one, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            return node;
+        }
+
+        static void retire(Word::value_type old) noexcept {
+            // Loads in flight on the old node each still owe it one reference, the cell gives up its own
+            Word::pointer< Node >(old)->release(1 - Word::count(old));
+        }
+
+        mutable std::atomic< Word::value_type > word;
+    };
+
+    using atomic_any = atomic_snapshot< any >;
+
+} // namespace mr
+
+#endif // !defined(ATOMIC_ANY_H_INCLUDED_ED9074E3_4B96_4DAE_B34A_747B767C589F)
@@ -0,0 +1,360 @@
+#if !defined(CALLBACK_QUEUE_H_INCLUDED_A4A2B595_8F07_4AC3_9F4C_5ED51FC60CB2)
+    #define CALLBACK_QUEUE_H_INCLUDED_A4A2B595_8F07_4AC3_9F4C_5ED51FC60CB2
+
+// Bounded lock-free queue of erased callbacks for handing work to a consumer thread. Each ring slot is a table pointer
+// followed by raw storage, the same model as mr::function: a callback is constructed directly in its slot, invoked
+// there by the consumer and destroyed in place, so callbacks fitting the slot never allocate nor move.
+
+    #include <atomic>
+    #include <bit>
+    #include <constexpr_function.h>
+    #include <cstddef>
+    #include <functional>
+    #include <memory>
+    #include <new>
+    #include <thread>
+    #include <type_traits>
+    #include <utility>
+
+namespace mr {
+
+    inline constexpr std::size_t callback_slot_size = 6 * sizeof(void*);
+
+    namespace detail {
+
+        inline constexpr std::size_t callback_queue_cache_line = 64;
+
+        // One table per callable type and placement. consume invokes the callback, then destroys it even when the
+        // call throws.
+        template < class... Args >
+        struct callback_table {
+            void (*consume)(void*, Args&...);
+            void (*destroy)(void*) noexcept;
+        };
+
+        template < class Callable, bool Inline, class... Args >
+        struct callback_thunks {
+            template < class... CArgs >
+            static void create(void* Storage, CArgs&&... args) {
+                if constexpr (Inline) {
+                    ::new (Storage) Callable(std::forward< CArgs >(args)...);
+                } else {
+                    ::new (Storage) Callable*(new Callable(std::forward< CArgs >(args)...));
+                }
+            }
+
+            static Callable& get(void* Storage) noexcept {
+                if constexpr (Inline) {
+                    return *std::launder(static_cast< Callable* >(Storage));
+                } else {
+                    return **std::launder(static_cast< Callable** >(Storage));
+                }
+            }
+
+            static void destroy(void* Storage) noexcept {
+                if constexpr (Inline) {
+                    std::destroy_at(std::addressof(get(Storage)));
+                } else {
+                    delete std::addressof(get(Storage));
+                }
+            }
+
+            static void consume(void* Storage, Args&... args) {
+                struct guard {
+                    ~guard() {
+                        destroy(storage);
+                    }
+                    void* storage;
+                };
+                const guard Destroy { Storage };
+                std::invoke(get(Storage), args...);
+            }
+        };
+
+        template < class Callable, bool Inline, class... Args >
+        inline constexpr callback_table< Args... > callback_table_for {
+            &callback_thunks< Callable, Inline, Args... >::consume,
+            &callback_thunks< Callable, Inline, Args... >::destroy,
+        };
+
+        // Stores an index when leaving scope, so a slot is published or released even when its callback throws
+        struct callback_ring_store {
+            ~callback_ring_store() {
+                index.store(value, std::memory_order_release);
+            }
+
+            std::atomic< std::size_t >& index;
+            std::size_t                 value;
+        };
+
+        // Single producer, single consumer: each side owns one index and caches the other one
+        template < class Payload >
+        class callback_ring_spsc {
+            struct alignas(callback_queue_cache_line) cell {
+                Payload value {};
+            };
+
+          public:
+            explicit callback_ring_spsc(std::size_t capacity) :
+                mask(capacity - 1), cells(std::make_unique< cell[] >(capacity)) {
+            }
+
+            // Producer only. Returns false when full, write is not called then.
+            template < class Write >
+            bool try_produce(Write&& write) {
+                const std::size_t t = tail.load(std::memory_order_relaxed);
+                if (t - cached_head > mask) {
+                    cached_head = head.load(std::memory_order_acquire);
+                    if (t - cached_head > mask) {
+                        return false;
+                    }
+                }
+                write(cells[t & mask].value);
+                tail.store(t + 1, std::memory_order_release);
+                return true;
+            }
+
+            // Consumer only. Returns false when empty, the slot is released even when read throws.
+            template < class Read >
+            bool try_consume(Read&& read) {
+                const std::size_t h = head.load(std::memory_order_relaxed);
+                if (h == cached_tail) {
+                    cached_tail = tail.load(std::memory_order_acquire);
+                    if (h == cached_tail) {
+                        return false;
+                    }
+                }
+                const callback_ring_store Release { head, h + 1 };
+                read(cells[h & mask].value);
+                return true;
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept {
+                const std::size_t h = head.load(std::memory_order_acquire);
+                return tail.load(std::memory_order_acquire) - h;
+            }
+
+            [[nodiscard]] std::size_t capacity() const noexcept {
+                return mask + 1;
+            }
+
+          private:
+            const std::size_t         mask;
+            std::unique_ptr< cell[] > cells;
+
+            alignas(callback_queue_cache_line) std::atomic< std::size_t > tail { 0 };
+            std::size_t cached_head { 0 };
+
+            alignas(callback_queue_cache_line) std::atomic< std::size_t > head { 0 };
+            std::size_t cached_tail { 0 };
+        };
+
+        // Multiple producers, single consumer: producers claim a position with a compare-exchange of the tail and
+        // every cell carries a sequence number telling whether it is free, published or still being written
+        template < class Payload >
+        class callback_ring_mpsc {
+            struct alignas(callback_queue_cache_line) cell {
+                std::atomic< std::size_t > sequence { 0 };
+                Payload                    value {};
+            };
+
+          public:
+            explicit callback_ring_mpsc(std::size_t capacity) :
+                mask(capacity - 1), cells(std::make_unique< cell[] >(capacity)) {
+                for (std::size_t i = 0; i < capacity; ++i) {
+                    cells[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            // Any thread. Returns false when full, write is not called then. A claimed cell is published even when
+            // write throws, so write must leave the payload empty in that case.
+            template < class Write >
+            bool try_produce(Write&& write) {
+                std::size_t pos = tail.load(std::memory_order_relaxed);
+                for (;;) {
+                    cell&                cur  = cells[pos & mask];
+                    const std::ptrdiff_t diff = static_cast< std::ptrdiff_t >(
+                        cur.sequence.load(std::memory_order_acquire) - pos);
+                    if (diff == 0) {
+                        if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            const callback_ring_store Publish { cur.sequence, pos + 1 };
+                            write(cur.value);
+                            return true;
+                        }
+                    } else if (diff < 0) {
+                        return false;
+                    } else {
+                        pos = tail.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            // Consumer only. Returns false when empty or when the oldest claimed cell is still being written.
+            template < class Read >
+            bool try_consume(Read&& read) {
+                const std::size_t h   = head.load(std::memory_order_relaxed);
+                cell&             cur = cells[h & mask];
+                if (cur.sequence.load(std::memory_order_acquire) != h + 1) {
+                    return false;
+                }
+                head.store(h + 1, std::memory_order_relaxed);
+                const callback_ring_store Release { cur.sequence, h + mask + 1 };
+                read(cur.value);
+                return true;
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept {
+                const std::size_t h = head.load(std::memory_order_acquire);
+                const std::size_t t = tail.load(std::memory_order_acquire);
+                return t > h ? t - h : 0;
+            }
+
+            [[nodiscard]] std::size_t capacity() const noexcept {
+                return mask + 1;
+            }
+
+          private:
+            const std::size_t         mask;
+            std::unique_ptr< cell[] > cells;
+
+            alignas(callback_queue_cache_line) std::atomic< std::size_t > tail { 0 };
+            alignas(callback_queue_cache_line) std::atomic< std::size_t > head { 0 };
+        };
+
+    } // namespace detail
+
+    // Producer policies of mr::basic_callback_queue
+    // One thread pushes, another one drains
+    struct single_producer {
+        template < class Payload >
+        using callback_ring = detail::callback_ring_spsc< Payload >;
+    };
+
+    // Any number of threads push, one thread drains
+    struct multi_producer {
+        template < class Payload >
+        using callback_ring = detail::callback_ring_mpsc< Payload >;
+    };
+
+    template < class Sig, class Producers = multi_producer, std::size_t SlotSize = callback_slot_size >
+    class basic_callback_queue;
+
+    template < class Ret, class... Args, class Producers, std::size_t SlotSize >
+    class basic_callback_queue< Ret(Args...), Producers, SlotSize > {
+        static_assert(SlotSize >= sizeof(void*), "mr::basic_callback_queue slots must be able to hold a pointer");
+
+        using Table = detail::callback_table< Args... >;
+
+        static constexpr std::size_t Align = alignof(void*);
+
+        struct payload {
+            template < class Callable, class... CArgs >
+            void emplace(CArgs&&... args) {
+                constexpr bool Inline = sizeof(Callable) <= SlotSize && alignof(Callable) <= Align;
+                detail::callback_thunks< Callable, Inline, Args... >::create(buffer, std::forward< CArgs >(args)...);
+                table = std::addressof(detail::callback_table_for< Callable, Inline, Args... >);
+            }
+
+            // False for a slot whose construction threw
+            bool consume(Args&... args) {
+                if (!table) {
+                    return false;
+                }
+                std::exchange(table, nullptr)->consume(buffer, args...);
+                return true;
+            }
+
+            void reset() noexcept {
+                if (table) {
+                    std::exchange(table, nullptr)->destroy(buffer);
+                }
+            }
+
+            const Table* table { nullptr };
+            alignas(Align) unsigned char buffer[SlotSize];
+        };
+
+      public:
+        template < class Callable >
+        static constexpr bool is_valid_v = !std::is_same_v< std::decay_t< Callable >, basic_callback_queue > &&
+                                           std::is_invocable_r_v< Ret, std::decay_t< Callable >&, Args&... >;
+
+        // Capacity is rounded up to a power of two
+        explicit basic_callback_queue(std::size_t capacity) :
+            ring(std::bit_ceil(capacity < 2 ? std::size_t { 2 } : capacity)) {
+        }
+
+        basic_callback_queue(const basic_callback_queue&)            = delete;
+        basic_callback_queue& operator=(const basic_callback_queue&) = delete;
+
+        // Callbacks never drained are destroyed without being invoked
+        ~basic_callback_queue() {
+            while (ring.try_consume([](payload& Slot) { Slot.reset(); })) {
+            }
+        }
+
+        // Returns false when the queue is full. Empty callables (null pointers, empty mr::function) are not queued.
+        template < class Callable, std::enable_if_t< is_valid_v< Callable >, int > = 0 >
+        bool try_push(Callable&& Fn) {
+            if (detail::constexpr_function_base::is_null_function(Fn)) {
+                return true;
+            }
+            return try_emplace< std::decay_t< Callable > >(std::forward< Callable >(Fn));
+        }
+
+        // Constructs a Callable from args directly in the slot. Returns false when the queue is full.
+        template < class Callable, class... CArgs >
+        bool try_emplace(CArgs&&... args) {
+            static_assert(is_valid_v< Callable >, "Callable is not invocable with the queue's signature");
+            return ring.try_produce(
+                [&](payload& Slot) { Slot.template emplace< Callable >(std::forward< CArgs >(args)...); });
+        }
+
+        // Yields until the callable fits
+        template < class Callable, std::enable_if_t< is_valid_v< Callable >, int > = 0 >
+        void push(Callable&& Fn) {
+            // try_push only consumes Fn when it succeeds
+            while (!try_push(std::forward< Callable >(Fn))) {
+                std::this_thread::yield();
+            }
+        }
+
+        // Consumer only. Invokes up to max callbacks in FIFO order, every one of them receiving args as lvalues, and
+        // returns how many ran. A callback that throws is destroyed and its slot released before the exception leaves.
+        std::size_t drain(std::size_t max, Args... args) {
+            std::size_t count = 0;
+            while (count < max && ring.try_consume([&](payload& Slot) {
+                       if (Slot.consume(args...)) {
+                           ++count;
+                       }
+                   })) {
+            }
+            return count;
+        }
+
+        // Approximate while producers or the consumer are running
+        [[nodiscard]] std::size_t size() const noexcept {
+            return ring.size();
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        [[nodiscard]] std::size_t capacity() const noexcept {
+            return ring.capacity();
+        }
+
+      private:
+        typename Producers::template callback_ring< payload > ring;
+    };
+
+    template < class Sig, std::size_t SlotSize = callback_slot_size >
+    using callback_queue = basic_callback_queue< Sig, multi_producer, SlotSize >;
+
+    template < class Sig, std::size_t SlotSize = callback_slot_size >
+    using spsc_callback_queue = basic_callback_queue< Sig, single_producer, SlotSize >;
+
+} // namespace mr
+
+#endif // !defined(CALLBACK_QUEUE_H_INCLUDED_A4A2B595_8F07_4AC3_9F4C_5ED51FC60CB2)
@@ -2,10 +2,14 @@
     #define CONSTEXPR_ANY_H_INCLUDED_DB3AE22A_59A1_4B53_804D_0D0989C7B5FF
 
     #include <any>
+    #include <constexpr_exceptions.h>
     #include <cstddef>
+    #include <erasure_counters.h>
     #include <memory>
     #include <new>
+    #include <optional>
     #include <type_traits>
+    #include <utility>
 
 namespace mr {
 
@@ -86,6 +90,22 @@ namespace mr {
             TypeIdFn  get_typeid;
         };
 
+        // Whether std::any keeps a T without allocating. The inline buffer is sizeof(std::any) less the manager
+        // pointer in libstdc++ and libc++, MSVC's STL keeps a little less for non-trivial types.
+        template < class T >
+        inline constexpr bool std_any_stores_inline_v = sizeof(T) <= sizeof(std::any) - sizeof(void*) &&
+                                                        alignof(T) <= alignof(void*) &&
+                                                        std::is_nothrow_move_constructible_v< T >;
+
+        // Counts the construction of a T, the only point where its storage is known from its type
+        template < class T >
+        constexpr void count_any_emplace() noexcept {
+            count_erasure_storage< T >(!std_any_stores_inline_v< T >);
+            if constexpr (!std_any_stores_inline_v< T >) {
+                count_erasure< T >(erasure_event::Allocation);
+            }
+        }
+
         template < class T >
         inline constexpr Any_type_table any_type_table = { std::addressof(Any_type_table::Destroy< T >),
                                                            std::addressof(Any_type_table::Copy< T >),
@@ -93,6 +113,14 @@ namespace mr {
 
     } // namespace detail
 
+    // constexpr std::type_index-like key, one distinct address per type
+    using type_id = detail::any_type_base::TypeId;
+
+    template < class T >
+    [[nodiscard]] constexpr type_id type_id_of() noexcept {
+        return detail::Any_type_table::TypeID< std::remove_cvref_t< T > >();
+    }
+
     class [[nodiscard]] any {
       public:
         constexpr any() = default;
@@ -106,13 +134,27 @@ namespace mr {
                     }
                 } else {
                     std::construct_at(std::addressof(get_std_any()), rhs.get_std_any());
+                    if constexpr (detail::erasure_counters_enabled) {
+                        if (rhs.has_value()) {
+                            detail::count_erasure(rhs.type(), detail::erasure_event::Copy,
+                                                  detail::erasure_event::Allocation);
+                        }
+                    }
                 }
             }
         }
 
         constexpr any(any&& rhs) noexcept {
-            if (std::addressof(rhs) != this) {
-                move_from(std::move(rhs));
+            if (std::is_constant_evaluated()) {
+                data.constexprData = std::exchange(rhs.data.constexprData, ConstexprData {});
+            } else {
+                if constexpr (detail::erasure_counters_enabled) {
+                    if (rhs.has_value()) {
+                        detail::count_erasure(rhs.type(), detail::erasure_event::Move);
+                    }
+                }
+                std::construct_at(std::addressof(get_std_any()), std::move(rhs.get_std_any()));
+                rhs.get_std_any().reset(); // ensure that the moved-from object is empty
             }
         }
 
@@ -127,6 +169,7 @@ namespace mr {
                 do_emplace< std::decay_t< Type > >(std::forward< Type >(value));
             } else {
                 std::construct_at(std::addressof(get_std_any()), std::forward< Type >(value));
+                detail::count_any_emplace< std::decay_t< Type > >();
             }
         }
 
@@ -140,6 +183,7 @@ namespace mr {
             } else {
                 std::construct_at(std::addressof(get_std_any()), std::in_place_type< Type >,
                                   std::forward< Args >(args)...);
+                detail::count_any_emplace< std::decay_t< Type > >();
             }
         }
 
@@ -155,6 +199,7 @@ namespace mr {
             } else {
                 std::construct_at(std::addressof(get_std_any()), std::in_place_type< Type >, il,
                                   std::forward< Args >(args)...);
+                detail::count_any_emplace< std::decay_t< Type > >();
             }
         }
 
@@ -186,6 +231,7 @@ namespace mr {
             if (std::is_constant_evaluated()) {
                 return do_emplace< std::decay_t< Type > >(std::forward< Args >(args)...);
             } else {
+                detail::count_any_emplace< std::decay_t< Type > >();
                 return get_std_any().emplace< std::decay_t< Type > >(std::forward< Args >(args)...);
             }
         }
@@ -201,6 +247,7 @@ namespace mr {
             if (std::is_constant_evaluated()) {
                 return do_emplace< std::decay_t< Type > >(il, std::forward< Args >(args)...);
             } else {
+                detail::count_any_emplace< std::decay_t< Type > >();
                 return get_std_any().emplace< std::decay_t< Type > >(il, std::forward< Args >(args)...);
             }
         }
@@ -213,6 +260,11 @@ namespace mr {
                     data.constexprData.table = nullptr;
                 }
             } else {
+                if constexpr (detail::erasure_counters_enabled) {
+                    if (has_value()) {
+                        detail::count_erasure(type(), detail::erasure_event::Count, detail::erasure_event::Free);
+                    }
+                }
                 get_std_any().reset();
             }
         }
@@ -237,7 +289,9 @@ namespace mr {
                 }
                 return static_cast< const detail::any_type< T >* >(data.constexprData.ptr)->get_data();
             } else {
-                return std::any_cast< T >(std::addressof(get_std_any()));
+                auto* Value = std::any_cast< T >(std::addressof(get_std_any()));
+                detail::count_erasure< T >(Value ? detail::erasure_event::Cast_hit : detail::erasure_event::Cast_miss);
+                return Value;
             }
         }
 
@@ -249,7 +303,9 @@ namespace mr {
                 }
                 return static_cast< detail::any_type< T >* >(data.constexprData.ptr)->get_data();
             } else {
-                return std::any_cast< T >(std::addressof(get_std_any()));
+                auto* Value = std::any_cast< T >(std::addressof(get_std_any()));
+                detail::count_erasure< T >(Value ? detail::erasure_event::Cast_hit : detail::erasure_event::Cast_miss);
+                return Value;
             }
         }
 
@@ -297,6 +353,11 @@ namespace mr {
             if (std::is_constant_evaluated()) {
                 data.constexprData = std::exchange(val.data.constexprData, ConstexprData {});
             } else {
+                if constexpr (detail::erasure_counters_enabled) {
+                    if (val.has_value()) {
+                        detail::count_erasure(val.type(), detail::erasure_event::Move);
+                    }
+                }
                 get_std_any() = std::move(val.get_std_any());
                 val.get_std_any().reset(); // ensure that the moved-from object is empty
             }
@@ -381,9 +442,9 @@ namespace mr {
                       "any_cast<T>(const any&) requires std::remove_cv_t<T> to be constructible from "
                       "const std::remove_cv_t<std::remove_reference_t<T>>&");
 
-        const auto ptr = any_cast< std::remove_cvref_t< T > >(std::addressof(value));
+        const auto ptr = value.template cast_to< std::remove_cvref_t< T > >();
         if (!ptr) {
-            throw std::bad_any_cast {};
+            detail::throw_or_terminate< std::bad_any_cast >();
         }
 
         return static_cast< std::remove_cv_t< T > >(*ptr);
@@ -395,9 +456,9 @@ namespace mr {
                       "any_cast<T>(any&) requires std::remove_cv_t<T> to be constructible from "
                       "std::remove_cv_t<std::remove_reference_t<T>>&");
 
-        const auto ptr = any_cast< std::remove_cvref_t< T > >(std::addressof(value));
+        const auto ptr = value.template cast_to< std::remove_cvref_t< T > >();
         if (!ptr) {
-            throw std::bad_any_cast {};
+            detail::throw_or_terminate< std::bad_any_cast >();
         }
 
         return static_cast< std::remove_cv_t< T > >(*ptr);
@@ -409,14 +470,40 @@ namespace mr {
                       "any_cast<T>(any&&) requires std::remove_cv_t<T> to be constructible from "
                       "std::remove_cv_t<std::remove_reference_t<T>>");
 
-        const auto ptr = any_cast< std::remove_cvref_t< T > >(std::addressof(value));
+        const auto ptr = value.template cast_to< std::remove_cvref_t< T > >();
         if (!ptr) {
-            throw std::bad_any_cast {};
+            detail::throw_or_terminate< std::bad_any_cast >();
         }
 
         return static_cast< std::remove_cv_t< T > >(std::move(*ptr));
     }
 
+    // Non-throwing counterparts of any_cast by value, for builds without exceptions. Empty when value does not hold
+    // a std::remove_cvref_t<T>.
+    template < class T >
+    [[nodiscard]] constexpr std::optional< std::remove_cvref_t< T > > try_any_cast(const any& value) {
+        if (const auto ptr = value.template cast_to< std::remove_cvref_t< T > >()) {
+            return std::optional< std::remove_cvref_t< T > > { std::in_place, *ptr };
+        }
+        return std::nullopt;
+    }
+
+    template < class T >
+    [[nodiscard]] constexpr std::optional< std::remove_cvref_t< T > > try_any_cast(any& value) {
+        if (const auto ptr = value.template cast_to< std::remove_cvref_t< T > >()) {
+            return std::optional< std::remove_cvref_t< T > > { std::in_place, *ptr };
+        }
+        return std::nullopt;
+    }
+
+    template < class T >
+    [[nodiscard]] constexpr std::optional< std::remove_cvref_t< T > > try_any_cast(any&& value) {
+        if (const auto ptr = value.template cast_to< std::remove_cvref_t< T > >()) {
+            return std::optional< std::remove_cvref_t< T > > { std::in_place, std::move(*ptr) };
+        }
+        return std::nullopt;
+    }
+
 } // namespace mr
 
 #endif // !defined(CONSTEXPR_ANY_H_INCLUDED_DB3AE22A_59A1_4B53_804D_0D0989C7B5FF)
@@ -0,0 +1,299 @@
+#if !defined(CONSTEXPR_ANY_RANGE_H_INCLUDED_162B0406_3F4C_48D4_BD02_7A11F2E228F7)
+    #define CONSTEXPR_ANY_RANGE_H_INCLUDED_162B0406_3F4C_48D4_BD02_7A11F2E228F7
+
+// Erased input ranges over the storage of mr::function. Element-wise iteration costs one indirect call per element,
+// next_chunk() moves up to a whole span of elements with one indirect call, the copy loop being instantiated for the
+// concrete iterator where it can be inlined and vectorized.
+
+    #include <algorithm>
+    #include <constexpr_function.h>
+    #include <cstddef>
+    #include <iterator>
+    #include <memory>
+    #include <optional>
+    #include <ranges>
+    #include <span>
+    #include <type_traits>
+    #include <utility>
+
+namespace mr {
+
+    template < class T >
+    class any_iterator;
+
+    template < class T >
+    class any_range;
+
+    namespace detail {
+
+        using any_range_storage = basic_constexpr_function_storage< sbo_storage<>, move_only_ownership >;
+
+        template < class T >
+        struct any_iterator_table {
+            bool (*do_op)(const any_range_storage&, any_range_storage&, constexpr_function_op);
+            void (*next)(any_range_storage&, std::optional< T >&);
+            std::size_t (*next_chunk)(any_range_storage&, std::span< T >);
+        };
+
+        // Position and end of a concrete range
+        template < class It, class Sentinel >
+        struct any_range_cursor {
+            It       it;
+            Sentinel end;
+        };
+
+        template < class Cursor, class T >
+        struct any_iterator_thunks {
+            static constexpr Cursor& get(any_range_storage& In) noexcept {
+                return *any_range_storage::get_function_pointer< Cursor >(In);
+            }
+
+            static constexpr void next(any_range_storage& In, std::optional< T >& Out) {
+                Cursor& cursor = get(In);
+                if (cursor.it == cursor.end) {
+                    Out.reset();
+                    return;
+                }
+                Out.emplace(*cursor.it);
+                ++cursor.it;
+            }
+
+            static constexpr std::size_t next_chunk(any_range_storage& In, std::span< T > Out) {
+                Cursor& cursor = get(In);
+                if constexpr (std::sized_sentinel_for< decltype(cursor.end), decltype(cursor.it) >) {
+                    // Counted copy without a per element end check
+                    const auto        left  = static_cast< std::size_t >(cursor.end - cursor.it);
+                    const std::size_t count = left < Out.size() ? left : Out.size();
+                    cursor.it = std::ranges::copy_n(std::move(cursor.it), static_cast< std::ptrdiff_t >(count),
+                                                    Out.begin())
+                                    .in;
+                    return count;
+                } else {
+                    auto              it    = std::move(cursor.it);
+                    const std::size_t size  = Out.size();
+                    std::size_t       count = 0;
+                    for (; count < size && it != cursor.end; ++it, ++count) {
+                        Out[count] = *it;
+                    }
+                    cursor.it = std::move(it);
+                    return count;
+                }
+            }
+        };
+
+        template < class Cursor, class T >
+        inline constexpr any_iterator_table< T > any_iterator_table_for {
+            &any_range_storage::Do_op< Cursor >,
+            &any_iterator_thunks< Cursor, T >::next,
+            &any_iterator_thunks< Cursor, T >::next_chunk,
+        };
+
+        template < class T >
+        struct any_range_table {
+            bool (*do_op)(const any_range_storage&, any_range_storage&, constexpr_function_op);
+            any_iterator< T > (*begin)(any_range_storage&);
+        };
+
+        template < class View, class T >
+        struct any_range_thunks {
+            static constexpr any_iterator< T > begin(any_range_storage& In) {
+                View& view = *any_range_storage::get_function_pointer< View >(In);
+                return any_iterator< T > { any_range_cursor< std::ranges::iterator_t< View >,
+                                                             std::ranges::sentinel_t< View > > {
+                    std::ranges::begin(view), std::ranges::end(view) } };
+            }
+        };
+
+        template < class View, class T >
+        inline constexpr any_range_table< T > any_range_table_for {
+            &any_range_storage::Do_op< View >,
+            &any_range_thunks< View, T >::begin,
+        };
+
+    } // namespace detail
+
+    // Move-only erased input iterator producing T, compared against std::default_sentinel. The current element is
+    // read ahead, so dereferencing makes no indirect call.
+    template < class T >
+    class any_iterator {
+        static_assert(std::is_object_v< T > && !std::is_const_v< T >,
+                      "mr::any_iterator elements are produced by value, T must be a non-const object type");
+
+        using Table = detail::any_iterator_table< T >;
+
+        template < class Cursor, class U >
+        friend struct detail::any_range_thunks;
+
+        template < class It, class Sentinel >
+        constexpr explicit any_iterator(detail::any_range_cursor< It, Sentinel >&& Cursor) {
+            using Cursor_t = detail::any_range_cursor< It, Sentinel >;
+            detail::any_range_storage::create< Cursor_t >(storage, std::move(Cursor));
+            table = std::addressof(detail::any_iterator_table_for< Cursor_t, T >);
+            table->next(storage, current);
+        }
+
+      public:
+        using value_type      = T;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr any_iterator() noexcept = default;
+
+        // Iterates [First, Last) of any iterator whose elements convert to T
+        template < class It, class Sentinel,
+                   std::enable_if_t< std::is_convertible_v< std::iter_reference_t< It >, T >, int > = 0 >
+        constexpr any_iterator(It First, Sentinel Last) :
+            any_iterator(detail::any_range_cursor< It, Sentinel > { std::move(First), std::move(Last) }) {
+        }
+
+        constexpr any_iterator(any_iterator&& Val) noexcept(std::is_nothrow_move_constructible_v< T >) :
+            current(std::move(Val.current)) {
+            move_from(Val);
+            Val.current.reset();
+        }
+
+        constexpr any_iterator& operator=(any_iterator&& Val) noexcept(
+            std::is_nothrow_move_constructible_v< T > && std::is_nothrow_move_assignable_v< T >) {
+            if (this != std::addressof(Val)) {
+                reset();
+                move_from(Val);
+                current = std::move(Val.current);
+                Val.current.reset();
+            }
+            return *this;
+        }
+
+        constexpr ~any_iterator() {
+            reset();
+        }
+
+        constexpr const T& operator*() const noexcept {
+            return *current;
+        }
+
+        constexpr const T* operator->() const noexcept {
+            return std::addressof(*current);
+        }
+
+        constexpr any_iterator& operator++() {
+            table->next(storage, current);
+            return *this;
+        }
+
+        constexpr void operator++(int) {
+            ++*this;
+        }
+
+        constexpr bool operator==(std::default_sentinel_t) const noexcept {
+            return !current.has_value();
+        }
+
+        // Moves up to Out.size() elements to Out and returns how many, 0 once the range is exhausted. Apart from
+        // the element read ahead, the whole chunk is one indirect call.
+        constexpr std::size_t next_chunk(std::span< T > Out) {
+            if (Out.empty() || !current) {
+                return 0;
+            }
+            Out[0]                  = std::move(*current);
+            const std::size_t count = 1 + table->next_chunk(storage, Out.subspan(1));
+            table->next(storage, current);
+            return count;
+        }
+
+      private:
+        constexpr void reset() noexcept {
+            if (table) {
+                table->do_op(storage, storage, detail::constexpr_function_op::Destroy);
+                table = nullptr;
+            }
+        }
+
+        // Expects *this to be empty, Val is left without a cursor
+        constexpr void move_from(any_iterator& Val) noexcept {
+            if (Val.table) {
+                Val.table->do_op(Val.storage, storage, detail::constexpr_function_op::Move);
+                table = std::exchange(Val.table, nullptr);
+            }
+        }
+
+        detail::any_range_storage storage {};
+        const Table*              table { nullptr };
+        std::optional< T >        current {};
+    };
+
+    // Move-only erased input range of T. Lvalue ranges are referenced, rvalue ranges are moved into the any_range,
+    // both through std::views::all. Iterators are invalidated when the any_range is moved or destroyed.
+    template < class T >
+    class any_range {
+        using Table = detail::any_range_table< T >;
+
+        template < class R >
+        static constexpr bool is_valid_v =
+            !std::is_same_v< std::remove_cvref_t< R >, any_range > && std::ranges::viewable_range< R > &&
+            std::is_convertible_v< std::ranges::range_reference_t< std::views::all_t< R > >, T >;
+
+      public:
+        constexpr any_range() noexcept = default;
+
+        template < class R, std::enable_if_t< is_valid_v< R >, int > = 0 >
+        constexpr any_range(R&& Range) {
+            using View = std::views::all_t< R >;
+            detail::any_range_storage::create< View >(storage, std::views::all(std::forward< R >(Range)));
+            table = std::addressof(detail::any_range_table_for< View, T >);
+        }
+
+        constexpr any_range(any_range&& Val) noexcept {
+            move_from(Val);
+        }
+
+        constexpr any_range& operator=(any_range&& Val) noexcept {
+            if (this != std::addressof(Val)) {
+                reset();
+                move_from(Val);
+            }
+            return *this;
+        }
+
+        constexpr ~any_range() {
+            reset();
+        }
+
+        constexpr explicit operator bool() const noexcept {
+            return table != nullptr;
+        }
+
+        // An empty any_range is an empty range
+        constexpr any_iterator< T > begin() {
+            // Not a conditional expression, GCC 12 destroys its result early during constant evaluation
+            if (!table) {
+                return any_iterator< T > {};
+            }
+            return table->begin(storage);
+        }
+
+        constexpr std::default_sentinel_t end() const noexcept {
+            return std::default_sentinel;
+        }
+
+      private:
+        constexpr void reset() noexcept {
+            if (table) {
+                table->do_op(storage, storage, detail::constexpr_function_op::Destroy);
+                table = nullptr;
+            }
+        }
+
+        // Expects *this to be empty, Val is left empty
+        constexpr void move_from(any_range& Val) noexcept {
+            if (Val.table) {
+                Val.table->do_op(Val.storage, storage, detail::constexpr_function_op::Move);
+                table = std::exchange(Val.table, nullptr);
+            }
+        }
+
+        detail::any_range_storage storage {};
+        const Table*              table { nullptr };
+    };
+
+} // namespace mr
+
+#endif // !defined(CONSTEXPR_ANY_RANGE_H_INCLUDED_162B0406_3F4C_48D4_BD02_7A11F2E228F7)
@@ -0,0 +1,145 @@
+#if !defined(CONSTEXPR_BATCH_FUNCTION_H_INCLUDED_05153A3E_69D5_4E3C_AB9D_36B28C27D762)
+    #define CONSTEXPR_BATCH_FUNCTION_H_INCLUDED_05153A3E_69D5_4E3C_AB9D_36B28C27D762
+
+    #include <constexpr_exceptions.h>
+    #include <constexpr_function.h>
+    #include <cstddef>
+    #include <functional>
+    #include <span>
+    #include <stdexcept>
+    #include <type_traits>
+    #include <utility>
+
+namespace mr {
+
+    template < class F >
+    class batch_function;
+
+    namespace detail {
+
+        template < class Ret, class... Args >
+        struct batch_signature {
+            static_assert(!std::is_void_v< Ret > && !std::is_reference_v< Ret >,
+                          "mr::batch_function results are written to a span, Ret must be an object type");
+            static_assert(
+                ((!std::is_lvalue_reference_v< Args > || std::is_const_v< std::remove_reference_t< Args > >) && ...),
+                "mr::batch_function inputs are read-only, Args cannot be non-const lvalue references");
+
+            using type = void(std::span< Ret >, std::span< const std::remove_cvref_t< Args > >...);
+        };
+
+        // Runs a scalar callable over whole spans, instantiated once per callable type so the loop body is the
+        // callable itself and can be inlined and vectorized inside the erased thunk
+        template < class Callable, class Ret, class... Args >
+        struct batch_adapter {
+            constexpr void operator()(std::span< Ret > out, std::span< const std::remove_cvref_t< Args > >... in) {
+                const std::size_t count = out.size();
+                for (std::size_t i = 0; i < count; ++i) {
+                    out[i] = std::invoke(callable, in[i]...);
+                }
+            }
+
+            Callable callable;
+        };
+
+    } // namespace detail
+
+    // Erased callable processing spans of arguments. Constructible from callables taking the spans directly or from
+    // any scalar callable of signature Ret(Args...), which is then looped over inside the erased call.
+    template < class Ret, class... Args >
+    class batch_function< Ret(Args...) > {
+        using Batch_sig = typename detail::batch_signature< Ret, Args... >::type;
+        using Impl      = function< Batch_sig >;
+
+        template < class Callable >
+        using adapter_t = detail::batch_adapter< std::decay_t< Callable >, Ret, Args... >;
+
+        template < class Callable >
+        static constexpr bool is_batch_v =
+            std::is_invocable_r_v< void, std::decay_t< Callable >&, std::span< Ret >,
+                                   std::span< const std::remove_cvref_t< Args > >... >;
+
+        template < class Callable >
+        static constexpr bool is_scalar_v =
+            std::is_invocable_r_v< Ret, std::decay_t< Callable >&, const std::remove_cvref_t< Args >&... >;
+
+      public:
+        using result_type = Ret;
+
+        constexpr batch_function() noexcept = default;
+
+        constexpr batch_function(std::nullptr_t) noexcept {
+        }
+
+        template < class Callable,
+                   std::enable_if_t< std::conjunction_v<
+                                         std::negation< std::is_same< std::decay_t< Callable >, batch_function > >,
+                                         std::disjunction< std::bool_constant< is_batch_v< Callable > >,
+                                                           std::bool_constant< is_scalar_v< Callable > > > >,
+                                     int > = 0 >
+        constexpr batch_function(Callable&& Val) : impl(make_impl(std::forward< Callable >(Val))) {
+        }
+
+        // Processes out.size() elements, every input span must provide at least that many
+        constexpr void operator()(std::span< Ret > out, std::span< const std::remove_cvref_t< Args > >... in) const {
+            if (((in.size() < out.size()) || ...)) {
+                detail::throw_or_terminate< std::length_error >(
+                    "mr::batch_function: input span shorter than output span");
+            }
+            impl(out, in...);
+        }
+
+        // Single element convenience call, runs a batch of one
+        constexpr Ret operator()(const std::remove_cvref_t< Args >&... args) const {
+            Ret res {};
+            impl(std::span< Ret > { std::addressof(res), 1 },
+                 std::span< const std::remove_cvref_t< Args > > { std::addressof(args), 1 }...);
+            return res;
+        }
+
+        constexpr void swap(batch_function& Val) noexcept {
+            impl.swap(Val.impl);
+        }
+
+        constexpr explicit operator bool() const noexcept {
+            return static_cast< bool >(impl);
+        }
+
+        template < typename Callable >
+        constexpr Callable* target() noexcept {
+            const batch_function* C_function = this;
+            return const_cast< Callable* >(C_function->template target< Callable >());
+        }
+
+        template < typename Callable >
+        constexpr const Callable* target() const noexcept {
+            if (const auto* adapter = impl.template target< adapter_t< Callable > >()) {
+                return std::addressof(adapter->callable);
+            }
+            return impl.template target< Callable >();
+        }
+
+      private:
+        template < class Callable >
+        static constexpr Impl make_impl(Callable&& Val) {
+            if constexpr (is_batch_v< Callable >) {
+                return Impl { std::forward< Callable >(Val) };
+            } else {
+                if (detail::constexpr_function_base::is_null_function(Val)) {
+                    return Impl {};
+                }
+                return Impl { adapter_t< Callable > { std::forward< Callable >(Val) } };
+            }
+        }
+
+        Impl impl {};
+    };
+
+    template < class Ret, class... Args >
+    constexpr void swap(batch_function< Ret(Args...) >& lhs, batch_function< Ret(Args...) >& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+} // namespace mr
+
+#endif // !defined(CONSTEXPR_BATCH_FUNCTION_H_INCLUDED_05153A3E_69D5_4E3C_AB9D_36B28C27D762)
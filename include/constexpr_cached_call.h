@@ -0,0 +1,71 @@
+#if !defined(CONSTEXPR_CACHED_CALL_H_INCLUDED_3418485A_F028_4680_AE7E_254493E7F316)
+    #define CONSTEXPR_CACHED_CALL_H_INCLUDED_3418485A_F028_4680_AE7E_254493E7F316
+
+// Inline caching of erased calls. A call site that mostly sees a few known callable types names them, and calls of
+// those types become direct, inlinable calls; any other type takes the erased call.
+
+    #include <constexpr_function.h>
+    #include <cstddef>
+    #include <tuple>
+    #include <type_traits>
+    #include <utility>
+
+namespace mr {
+
+    // Polymorphic inline cache over Candidates, one object per call site. The candidate seen last is tried first, so
+    // a monomorphic site costs one identity comparison on top of the inlined call. The cache is not synchronized,
+    // give each thread its own.
+    template < class... Candidates >
+    class cached_call {
+        static_assert(sizeof...(Candidates) != 0, "mr::cached_call requires at least one candidate callable type");
+
+        static constexpr std::size_t Npos = sizeof...(Candidates);
+
+        template < std::size_t I >
+        using candidate_t = std::decay_t< std::tuple_element_t< I, std::tuple< Candidates... > > >;
+
+      public:
+        // Calls Fn, any mr::basic_function, with args
+        template < class Function, class... CallArgs >
+        constexpr decltype(auto) operator()(const Function& Fn, CallArgs&&... args) {
+            return call_last< 0 >(Fn, std::forward< CallArgs >(args)...);
+        }
+
+        // Index in Candidates of the type seen last, sizeof...(Candidates) when it was none of them
+        [[nodiscard]] constexpr std::size_t last_index() const noexcept {
+            return last;
+        }
+
+      private:
+        template < std::size_t I, class Function, class... CallArgs >
+        constexpr decltype(auto) call_last(const Function& Fn, CallArgs&&... args) {
+            if constexpr (I == Npos) {
+                return search< 0 >(Fn, std::forward< CallArgs >(args)...);
+            } else {
+                if (last == I && Fn.template holds< candidate_t< I > >()) {
+                    return Fn.template invoke_as< candidate_t< I > >(std::forward< CallArgs >(args)...);
+                }
+                return call_last< I + 1 >(Fn, std::forward< CallArgs >(args)...);
+            }
+        }
+
+        template < std::size_t I, class Function, class... CallArgs >
+        constexpr decltype(auto) search(const Function& Fn, CallArgs&&... args) {
+            if constexpr (I == Npos) {
+                last = Npos;
+                return Fn(std::forward< CallArgs >(args)...);
+            } else {
+                if (I != last && Fn.template holds< candidate_t< I > >()) {
+                    last = I;
+                    return Fn.template invoke_as< candidate_t< I > >(std::forward< CallArgs >(args)...);
+                }
+                return search< I + 1 >(Fn, std::forward< CallArgs >(args)...);
+            }
+        }
+
+        std::size_t last { Npos };
+    };
+
+} // namespace mr
+
+#endif // !defined(CONSTEXPR_CACHED_CALL_H_INCLUDED_3418485A_F028_4680_AE7E_254493E7F316)
@@ -0,0 +1,235 @@
+#if !defined(CONSTEXPR_COMPOSE_H_INCLUDED_D733E0D0_5DC8_4778_AB62_46B7151A1EAB)
+    #define CONSTEXPR_COMPOSE_H_INCLUDED_D733E0D0_5DC8_4778_AB62_46B7151A1EAB
+
+// Function composition without nested erasure: stages of known type are fused into one callable holding all of them
+// by value, already erased mr::function< T(T) > stages are flattened into one erased chain looping over its stages.
+
+    #include <constexpr_function.h>
+    #include <cstddef>
+    #include <functional>
+    #include <iterator>
+    #include <tuple>
+    #include <type_traits>
+    #include <utility>
+    #include <vector>
+
+namespace mr {
+
+    template < class... Stages >
+    class pipeline;
+
+    namespace detail {
+
+        // compose order: the last stage is applied first
+        template < class... Fs >
+        class composed {
+            static_assert(sizeof...(Fs) != 0, "mr::compose requires at least one callable");
+
+          public:
+            constexpr explicit composed(std::tuple< Fs... > fs) : stages(std::move(fs)) {
+            }
+
+            template < class... Args >
+            constexpr decltype(auto) operator()(Args&&... args) {
+                return call< 0 >(stages, std::forward< Args >(args)...);
+            }
+
+            template < class... Args >
+            constexpr decltype(auto) operator()(Args&&... args) const {
+                return call< 0 >(stages, std::forward< Args >(args)...);
+            }
+
+            [[nodiscard]] constexpr const std::tuple< Fs... >& get_stages() const& noexcept {
+                return stages;
+            }
+
+            [[nodiscard]] constexpr std::tuple< Fs... >&& get_stages() && noexcept {
+                return std::move(stages);
+            }
+
+          private:
+            template < std::size_t I, class Tuple, class... Args >
+            static constexpr decltype(auto) call(Tuple& fs, Args&&... args) {
+                if constexpr (I + 1 == sizeof...(Fs)) {
+                    return std::invoke(std::get< I >(fs), std::forward< Args >(args)...);
+                } else {
+                    return std::invoke(std::get< I >(fs), call< I + 1 >(fs, std::forward< Args >(args)...));
+                }
+            }
+
+            std::tuple< Fs... > stages;
+        };
+
+        template < class... Fs >
+        constexpr composed< Fs... > make_composed(std::tuple< Fs... >&& fs) {
+            return composed< Fs... > { std::move(fs) };
+        }
+
+        // Nested compositions of the same kind are spliced into their parent instead of being stored as one stage
+        template < template < class... > class Kind, class F >
+        constexpr auto as_stages(F&& Fn) {
+            if constexpr (is_specialization_of_v< std::remove_cvref_t< F >, Kind >) {
+                return std::forward< F >(Fn).get_stages();
+            } else {
+                return std::tuple< std::decay_t< F > > { std::forward< F >(Fn) };
+            }
+        }
+
+        template < class F >
+        struct function_endomorphism {};
+        template < class T >
+        struct function_endomorphism< function< T(T) > > {
+            using type = T;
+        };
+
+        template < class F, class = void >
+        inline constexpr bool is_function_endomorphism_v = false;
+        template < class F >
+        inline constexpr bool
+            is_function_endomorphism_v< F, std::void_t< typename function_endomorphism< F >::type > > = true;
+
+        // Erased T(T) stages run in order by one erased call
+        template < class T >
+        class function_chain {
+          public:
+            using stage_type = function< T(T) >;
+
+            // Stages already holding a chain contribute their stages rather than themselves. Empty stages are kept,
+            // calling the chain then throws std::bad_function_call like calling them would.
+            constexpr void append(const stage_type& stage) {
+                if (const auto* chain = stage.template target< function_chain >()) {
+                    stages.insert(stages.end(), chain->stages.begin(), chain->stages.end());
+                } else {
+                    stages.push_back(stage);
+                }
+            }
+
+            constexpr void append(stage_type&& stage) {
+                if (auto* chain = stage.template target< function_chain >()) {
+                    stages.insert(stages.end(), std::make_move_iterator(chain->stages.begin()),
+                                  std::make_move_iterator(chain->stages.end()));
+                } else {
+                    stages.push_back(std::move(stage));
+                }
+            }
+
+            constexpr T operator()(T value) const {
+                for (const auto& stage : stages) {
+                    value = stage(std::move(value));
+                }
+                return value;
+            }
+
+            [[nodiscard]] constexpr std::size_t size() const noexcept {
+                return stages.size();
+            }
+
+          private:
+            std::vector< stage_type > stages;
+        };
+
+        // Appends the stages last to first, the innermost runs first
+        template < class T, class Stages, std::size_t... I >
+        constexpr void append_reversed(function_chain< T >& chain, Stages&& stages, std::index_sequence< I... >) {
+            constexpr std::size_t Last = sizeof...(I) - 1;
+            (chain.append(std::get< Last - I >(std::forward< Stages >(stages))), ...);
+        }
+
+    } // namespace detail
+
+    // compose(f, g, h)(args...) == f(g(h(args...)))
+    //
+    // With mr::function< T(T) > arguments only, the result is a single mr::function< T(T) > looping over the
+    // flattened stages. Otherwise every stage is stored by value in one fused callable, ready to be erased once.
+    template < class... Fs >
+    [[nodiscard]] constexpr auto compose(Fs&&... fs) {
+        static_assert(sizeof...(Fs) != 0, "mr::compose requires at least one callable");
+
+        using First = std::remove_cvref_t< std::tuple_element_t< 0, std::tuple< Fs... > > >;
+        if constexpr ((detail::is_function_endomorphism_v< First > && ... &&
+                       std::is_same_v< std::remove_cvref_t< Fs >, First >)) {
+            using T = typename detail::function_endomorphism< First >::type;
+
+            detail::function_chain< T > chain {};
+            detail::append_reversed(chain, std::forward_as_tuple(std::forward< Fs >(fs)...),
+                                    std::index_sequence_for< Fs... > {});
+            return First { std::move(chain) };
+        } else {
+            return detail::make_composed(
+                std::tuple_cat(detail::as_stages< detail::composed >(std::forward< Fs >(fs))...));
+        }
+    }
+
+    // Left to right composition builder: (mr::pipeline {} | f | g | h)(args...) == h(g(f(args...)))
+    template < class... Stages >
+    class pipeline {
+      public:
+        constexpr pipeline() = default;
+
+        constexpr explicit pipeline(std::tuple< Stages... > fs) : stages(std::move(fs)) {
+        }
+
+        template < class F >
+        [[nodiscard]] constexpr auto then(F&& Fn) const& {
+            return make(std::tuple_cat(stages, detail::as_stages< mr::pipeline >(std::forward< F >(Fn))));
+        }
+
+        template < class F >
+        [[nodiscard]] constexpr auto then(F&& Fn) && {
+            return make(
+                std::tuple_cat(std::move(stages), detail::as_stages< mr::pipeline >(std::forward< F >(Fn))));
+        }
+
+        template < class F >
+        [[nodiscard]] constexpr auto operator|(F&& Fn) const& {
+            return then(std::forward< F >(Fn));
+        }
+
+        template < class F >
+        [[nodiscard]] constexpr auto operator|(F&& Fn) && {
+            return std::move(*this).then(std::forward< F >(Fn));
+        }
+
+        template < class... Args >
+        constexpr decltype(auto) operator()(Args&&... args) {
+            static_assert(sizeof...(Stages) != 0, "mr::pipeline without stages cannot be invoked");
+            return call< sizeof...(Stages) - 1 >(stages, std::forward< Args >(args)...);
+        }
+
+        template < class... Args >
+        constexpr decltype(auto) operator()(Args&&... args) const {
+            static_assert(sizeof...(Stages) != 0, "mr::pipeline without stages cannot be invoked");
+            return call< sizeof...(Stages) - 1 >(stages, std::forward< Args >(args)...);
+        }
+
+        [[nodiscard]] constexpr const std::tuple< Stages... >& get_stages() const& noexcept {
+            return stages;
+        }
+
+        [[nodiscard]] constexpr std::tuple< Stages... >&& get_stages() && noexcept {
+            return std::move(stages);
+        }
+
+      private:
+        template < class... Fs >
+        static constexpr pipeline< Fs... > make(std::tuple< Fs... >&& fs) {
+            return pipeline< Fs... > { std::move(fs) };
+        }
+
+        template < std::size_t I, class Tuple, class... Args >
+        static constexpr decltype(auto) call(Tuple& fs, Args&&... args) {
+            if constexpr (I == 0) {
+                return std::invoke(std::get< 0 >(fs), std::forward< Args >(args)...);
+            } else {
+                return std::invoke(std::get< I >(fs), call< I - 1 >(fs, std::forward< Args >(args)...));
+            }
+        }
+
+        std::tuple< Stages... > stages;
+    };
+
+    pipeline() -> pipeline<>;
+
+} // namespace mr
+
+#endif // !defined(CONSTEXPR_COMPOSE_H_INCLUDED_D733E0D0_5DC8_4778_AB62_46B7151A1EAB)
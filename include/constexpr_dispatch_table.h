@@ -0,0 +1,235 @@
+#if !defined(CONSTEXPR_DISPATCH_TABLE_H_INCLUDED_43E7F995_2D97_4BBA_A3DB_696CFD96511D)
+    #define CONSTEXPR_DISPATCH_TABLE_H_INCLUDED_43E7F995_2D97_4BBA_A3DB_696CFD96511D
+
+// Key -> callable tables built during constant evaluation. The keys are placed with a perfect hash (hash and
+// displace: a first hash picks a group, each group stores the displacement that sends its keys to free slots), the
+// callables are stored by value next to the table, so a lookup is one hash, one key compare and one indirect call.
+
+    #include <array>
+    #include <constexpr_exceptions.h>
+    #include <bit>
+    #include <cstddef>
+    #include <cstdint>
+    #include <functional>
+    #include <stdexcept>
+    #include <string_view>
+    #include <tuple>
+    #include <type_traits>
+    #include <utility>
+
+namespace mr {
+
+    template < class Key, class Callable >
+    struct dispatch_entry {
+        Key      key;
+        Callable callable;
+    };
+
+    template < class Key, class Callable >
+    dispatch_entry(Key, Callable) -> dispatch_entry< Key, Callable >;
+    template < class Callable >
+    dispatch_entry(const char*, Callable) -> dispatch_entry< std::string_view, Callable >;
+
+    namespace detail {
+
+        template < class >
+        inline constexpr bool Eval_dispatch_to_false = false;
+
+        // splitmix64 finalizer
+        [[nodiscard]] constexpr std::uint64_t dispatch_mix(std::uint64_t value) noexcept {
+            value ^= value >> 30;
+            value *= 0xBF58476D1CE4E5B9ull;
+            value ^= value >> 27;
+            value *= 0x94D049BB133111EBull;
+            value ^= value >> 31;
+            return value;
+        }
+
+        template < class Key >
+        [[nodiscard]] constexpr std::uint64_t dispatch_hash(const Key& key, std::uint64_t seed) noexcept {
+            if constexpr (std::is_integral_v< Key > || std::is_enum_v< Key >) {
+                return dispatch_mix(static_cast< std::uint64_t >(key) ^ seed);
+            } else if constexpr (std::is_same_v< Key, std::string_view >) {
+                // FNV-1a
+                std::uint64_t hash = 0xCBF29CE484222325ull ^ seed;
+                for (const char c : key) {
+                    hash ^= static_cast< unsigned char >(c);
+                    hash *= 0x100000001B3ull;
+                }
+                return dispatch_mix(hash);
+            } else {
+                static_assert(Eval_dispatch_to_false< Key >,
+                              "mr::dispatch_table keys must be integral, enumerations or std::string_view");
+            }
+        }
+
+        [[nodiscard]] constexpr std::size_t dispatch_slot(std::uint64_t hash, std::uint32_t displacement,
+                                                          std::size_t slots) noexcept {
+            return static_cast< std::size_t >(dispatch_mix(hash + displacement)) & (slots - 1);
+        }
+
+    } // namespace detail
+
+    template < class Key, class F, class... Callables >
+    class dispatch_table {
+        static_assert(detail::Eval_dispatch_to_false< F >,
+                      "Incorrect behaviour: non-function type was passed to mr::dispatch_table!");
+    };
+
+    template < class Key, class Ret, class... Args, class... Callables >
+    class dispatch_table< Key, Ret(Args...), Callables... > {
+        static_assert(sizeof...(Callables) != 0, "mr::dispatch_table requires at least one entry");
+        static_assert((std::is_invocable_r_v< Ret, const Callables&, Args... > && ...),
+                      "every mr::dispatch_table callable must be invocable with the table's signature");
+
+        using Storage = std::tuple< Callables... >;
+        using Call_fn = Ret (*)(const Storage&, Args&&...);
+
+        static constexpr std::size_t Entries = sizeof...(Callables);
+        static constexpr std::size_t Slots   = std::bit_ceil(Entries) * 2;
+        static constexpr std::size_t Groups  = std::bit_ceil((Entries + 1) / 2);
+
+        struct Slot {
+            Key     key {};
+            Call_fn call { nullptr };
+        };
+
+      public:
+        using key_type    = Key;
+        using result_type = Ret;
+
+        constexpr explicit dispatch_table(dispatch_entry< Key, Callables >... entries) :
+            callables(std::move(entries.callable)...) {
+            build(std::array< Key, Entries > { entries.key... }, std::index_sequence_for< Callables... > {});
+        }
+
+        [[nodiscard]] constexpr bool contains(const Key& key) const noexcept {
+            return find(key) != nullptr;
+        }
+
+        // Calls the callable registered under key, throws std::bad_function_call for unknown keys, or terminates
+        // without exceptions
+        constexpr Ret operator()(const Key& key, Args... args) const {
+            const Slot* slot = find(key);
+            if (!slot) {
+                detail::throw_or_terminate< std::bad_function_call >();
+            }
+            return slot->call(callables, std::forward< Args >(args)...);
+        }
+
+        [[nodiscard]] static constexpr std::size_t size() noexcept {
+            return Entries;
+        }
+
+      private:
+        template < std::size_t I >
+        static constexpr Ret Do_call(const Storage& In, Args&&... Types) {
+            return std::invoke(std::get< I >(In), std::forward< Args >(Types)...);
+        }
+
+        [[nodiscard]] constexpr const Slot* find(const Key& key) const noexcept {
+            const Slot& slot = slots[slot_of(detail::dispatch_hash(key, seed))];
+            return slot.call && slot.key == key ? std::addressof(slot) : nullptr;
+        }
+
+        [[nodiscard]] constexpr std::size_t slot_of(std::uint64_t hash) const noexcept {
+            return detail::dispatch_slot(hash, displacements[hash & (Groups - 1)], Slots);
+        }
+
+        template < std::size_t... Is >
+        constexpr void build(const std::array< Key, Entries >& keys, std::index_sequence< Is... >) {
+            for (std::size_t i = 0; i < Entries; ++i) {
+                for (std::size_t j = i + 1; j < Entries; ++j) {
+                    if (keys[i] == keys[j]) {
+                        detail::throw_or_terminate< std::invalid_argument >("mr::dispatch_table: duplicate key");
+                    }
+                }
+            }
+
+            constexpr std::array< Call_fn, Entries > Calls { &Do_call< Is >... };
+
+            for (seed = 0; seed < Max_seeds; ++seed) {
+                if (try_place(keys)) {
+                    for (std::size_t i = 0; i < Entries; ++i) {
+                        Slot& slot = slots[slot_of(detail::dispatch_hash(keys[i], seed))];
+                        slot.key   = keys[i];
+                        slot.call  = Calls[i];
+                    }
+                    return;
+                }
+            }
+            detail::throw_or_terminate< std::invalid_argument >("mr::dispatch_table: no perfect hash found");
+        }
+
+        // Places the largest groups first, each group gets the first displacement that maps all of its keys to
+        // distinct free slots
+        constexpr bool try_place(const std::array< Key, Entries >& keys) {
+            std::array< std::uint64_t, Entries > hashes {};
+            std::array< std::size_t, Groups >    group_sizes {};
+            for (std::size_t i = 0; i < Entries; ++i) {
+                hashes[i] = detail::dispatch_hash(keys[i], seed);
+                ++group_sizes[hashes[i] & (Groups - 1)];
+            }
+
+            std::array< bool, Slots >          taken {};
+            std::array< bool, Groups >         placed {};
+            std::array< std::size_t, Entries > candidate {};
+            for (std::size_t round = 0; round < Groups; ++round) {
+                std::size_t group = 0;
+                for (std::size_t g = 0; g < Groups; ++g) {
+                    if (!placed[g] && (placed[group] || group_sizes[g] > group_sizes[group])) {
+                        group = g;
+                    }
+                }
+                placed[group] = true;
+                if (group_sizes[group] == 0) {
+                    continue;
+                }
+
+                bool found = false;
+                for (std::uint32_t displacement = 0; !found && displacement < Max_displacement; ++displacement) {
+                    std::size_t members = 0;
+                    found               = true;
+                    for (std::size_t i = 0; found && i < Entries; ++i) {
+                        if ((hashes[i] & (Groups - 1)) != group) {
+                            continue;
+                        }
+                        const auto slot = detail::dispatch_slot(hashes[i], displacement, Slots);
+                        found           = !taken[slot];
+                        for (std::size_t m = 0; found && m < members; ++m) {
+                            found = candidate[m] != slot;
+                        }
+                        candidate[members++] = slot;
+                    }
+                    if (found) {
+                        displacements[group] = displacement;
+                        for (std::size_t m = 0; m < members; ++m) {
+                            taken[candidate[m]] = true;
+                        }
+                    }
+                }
+                if (!found) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static constexpr std::uint64_t Max_seeds        = 64;
+        static constexpr std::uint32_t Max_displacement = 1u << 16;
+
+        Storage                             callables;
+        std::uint64_t                       seed { 0 };
+        std::array< std::uint32_t, Groups > displacements {};
+        std::array< Slot, Slots >           slots {};
+    };
+
+    template < class F, class Key, class... Callables >
+    [[nodiscard]] constexpr dispatch_table< Key, F, Callables... >
+        make_dispatch_table(dispatch_entry< Key, Callables >... entries) {
+        return dispatch_table< Key, F, Callables... > { std::move(entries)... };
+    }
+
+} // namespace mr
+
+#endif // !defined(CONSTEXPR_DISPATCH_TABLE_H_INCLUDED_43E7F995_2D97_4BBA_A3DB_696CFD96511D)
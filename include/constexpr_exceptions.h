@@ -0,0 +1,40 @@
+#if !defined(CONSTEXPR_EXCEPTIONS_H_INCLUDED_A2F543C3_18B1_4EB5_A8D3_232F22B32A72)
+    #define CONSTEXPR_EXCEPTIONS_H_INCLUDED_A2F543C3_18B1_4EB5_A8D3_232F22B32A72
+
+// Error reporting of mr::any and mr::function. MR_EXCEPTIONS follows whether the compiler has exceptions enabled,
+// with it at 0 the failures that would throw call std::terminate instead. During constant evaluation either is a
+// compile error.
+
+    #if !defined(MR_EXCEPTIONS)
+        #if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+            #define MR_EXCEPTIONS 1
+        #else
+            #define MR_EXCEPTIONS 0
+        #endif
+    #endif
+
+    #include <exception>
+    #include <utility>
+
+namespace mr {
+
+    namespace detail {
+
+        inline constexpr bool exceptions_enabled = MR_EXCEPTIONS != 0;
+
+        // Throws Exception built from args, or terminates when exceptions are disabled
+        template < class Exception, class... Args >
+        [[noreturn]] constexpr void throw_or_terminate(Args&&... args) {
+    #if MR_EXCEPTIONS
+            throw Exception { std::forward< Args >(args)... };
+    #else
+            ((void)args, ...);
+            std::terminate();
+    #endif
+        }
+
+    } // namespace detail
+
+} // namespace mr
+
+#endif // !defined(CONSTEXPR_EXCEPTIONS_H_INCLUDED_A2F543C3_18B1_4EB5_A8D3_232F22B32A72)
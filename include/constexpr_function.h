@@ -3,20 +3,173 @@
 
 // Credits: this code mimics the behaviour of std::function from MSVC's STL, with changes to allow for constexpr
 // compilation.
+//
+// Defining MR_SHARED_THUNKS to 1 makes callables that are trivially copyable and destructible share their copy, move
+// and destroy thunks with every such callable of the same size and alignment, at run-time. Each type keeps its own
+// call thunk and type identity. Ignored when MR_ERASURE_COUNTERS is enabled, which counts per callable type.
 
+    #if !defined(MR_SHARED_THUNKS)
+        #define MR_SHARED_THUNKS 0
+    #endif
+
+    #include <atomic>
     #include <bit>
+    #include <constexpr_exceptions.h>
     #include <cstddef>
     #include <cstdint>
+    #include <erasure_counters.h>
     #include <functional>
+    #include <initializer_list>
     #include <memory>
+    #include <new>
+    #include <tuple>
     #include <type_traits>
+    #include <utility>
     #include <vector>
 
 namespace mr {
 
+    namespace detail {
+
+        template < class Callable, std::size_t Size, std::size_t Align >
+        inline constexpr bool constexpr_function_fits_v = sizeof(Callable) <= Size && alignof(Callable) <= Align &&
+                                                          std::is_nothrow_move_constructible_v< Callable >;
+
+        // Stand-in of every trivial callable of this size and alignment, the callable is created in its bytes
+        template < std::size_t Size, std::size_t Align >
+        struct constexpr_function_layout_t {
+            constexpr constexpr_function_layout_t() noexcept {
+            }
+
+            alignas(Align) unsigned char bytes[Size];
+        };
+
+        template < class Callable >
+        inline constexpr bool constexpr_function_shares_thunks_v =
+            MR_SHARED_THUNKS && !erasure_counters_enabled && std::is_trivially_copy_constructible_v< Callable > &&
+            std::is_trivially_move_constructible_v< Callable > && std::is_trivially_destructible_v< Callable >;
+        template < std::size_t Size, std::size_t Align >
+        inline constexpr bool constexpr_function_shares_thunks_v< constexpr_function_layout_t< Size, Align > > = false;
+
+        template < class Callable >
+        using constexpr_function_layout_of_t = constexpr_function_layout_t< sizeof(Callable), alignof(Callable) >;
+
+    } // namespace detail
+
+    // Storage policies decide where mr::basic_function keeps its callable at run-time. Constant evaluation cannot
+    // reuse raw bytes as an object, so every policy keeps the callable in a heap node while constant evaluated.
+
+    // Always a heap node
+    struct heap_storage {
+        static constexpr std::size_t size          = 0;
+        static constexpr std::size_t align         = alignof(void*);
+        static constexpr bool        heap_fallback = true;
+
+        template < class Callable >
+        static constexpr bool stores_inline_v = false;
+    };
+
+    // Inline when the callable fits and is nothrow move constructible, heap node otherwise
+    template < std::size_t Size = 3 * sizeof(void*), std::size_t Align = alignof(void*) >
+    struct sbo_storage {
+        static constexpr std::size_t size          = Size;
+        static constexpr std::size_t align         = Align;
+        static constexpr bool        heap_fallback = true;
+
+        template < class Callable >
+        static constexpr bool stores_inline_v = detail::constexpr_function_fits_v< Callable, Size, Align >;
+    };
+
+    // Inline only, callables that do not fit are rejected at compile time
+    template < std::size_t Size, std::size_t Align = alignof(std::max_align_t) >
+    struct inline_storage {
+        static constexpr std::size_t size          = Size;
+        static constexpr std::size_t align         = Align;
+        static constexpr bool        heap_fallback = false;
+
+        template < class Callable >
+        static constexpr bool stores_inline_v = detail::constexpr_function_fits_v< Callable, Size, Align >;
+    };
+
+    // Reference count policies of shared_ownership. Both use plain arithmetic during constant evaluation.
+    // Plain counter, for callables that never leave one thread
+    struct local_refcount {
+        template < class T >
+        static constexpr void increment(T& count) noexcept {
+            ++count;
+        }
+
+        // Returns true when the last reference was released
+        template < class T >
+        static constexpr bool decrement(T& count) noexcept {
+            return --count == 0;
+        }
+
+        template < class T >
+        static constexpr T load(const T& count) noexcept {
+            return count;
+        }
+    };
+
+    // Atomic counter at run-time, copies may be made and dropped concurrently
+    struct atomic_refcount {
+        template < class T >
+        static constexpr void increment(T& count) noexcept {
+            if (std::is_constant_evaluated()) {
+                ++count;
+            } else {
+                std::atomic_ref< T > { count }.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        template < class T >
+        static constexpr bool decrement(T& count) noexcept {
+            if (std::is_constant_evaluated()) {
+                return --count == 0;
+            }
+            return std::atomic_ref< T > { count }.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+
+        template < class T >
+        static constexpr T load(const T& count) noexcept {
+            if (std::is_constant_evaluated()) {
+                return count;
+            }
+            return std::atomic_ref< T > { const_cast< T& >(count) }.load(std::memory_order_acquire);
+        }
+    };
+
+    // Ownership policies decide what copying mr::basic_function means.
+    // Every copy owns a copy of the callable
+    struct unique_ownership {
+        static constexpr bool is_copyable = true;
+        static constexpr bool is_shared   = false;
+    };
+
+    // Copies share one immutable callable through an intrusive reference count, requires heap_storage
+    template < class RefCount = atomic_refcount >
+    struct shared_ownership {
+        using refcount_type = RefCount;
+
+        static constexpr bool is_copyable = true;
+        static constexpr bool is_shared   = true;
+    };
+
+    // Not copyable, accepts move-only callables
+    struct move_only_ownership {
+        static constexpr bool is_copyable = false;
+        static constexpr bool is_shared   = false;
+    };
+
+    template < class F, class Storage = sbo_storage<>, class Ownership = unique_ownership >
+    class basic_function;
+
     template < class F >
     class function;
 
+    template < class F, class Storage = sbo_storage<> >
+    using move_only_function = basic_function< F, Storage, move_only_ownership >;
+
     namespace detail {
 
         template < class Type, template < class... > class Template >
@@ -27,6 +180,15 @@ namespace mr {
         template < class Type, template < class... > class Template >
         struct is_specialization_of : std::bool_constant< is_specialization_of_v< Type, Template > > {};
 
+        template < class F, class Storage, class Ownership >
+        constexpr std::true_type is_basic_function_test(const basic_function< F, Storage, Ownership >*);
+        constexpr std::false_type is_basic_function_test(...);
+
+        // True for mr::basic_function and classes derived from it, such as mr::function
+        template < class T >
+        inline constexpr bool is_basic_function_v =
+            decltype(is_basic_function_test(std::declval< std::remove_cvref_t< T >* >()))::value;
+
         template < class >
         inline constexpr bool Eval_function_to_false = false;
 
@@ -39,96 +201,203 @@ namespace mr {
             }
         };
 
+        // Heap node holding the callable by value, one allocation per erased callable
         template < class Callable >
         struct constexpr_function_data_t : constexpr_function_storage_t {
             template < class... Args >
-            constexpr constexpr_function_data_t(Args&&... args) noexcept :
-                callable(new Callable { std::forward< Args >(args)... }) {
-            }
-            constexpr ~constexpr_function_data_t() noexcept {
-                delete callable;
+            constexpr explicit constexpr_function_data_t(Args&&... args) : callable(std::forward< Args >(args)...) {
             }
 
             inline static constexpr std::uint8_t Type_id = 0;
 
-            Callable* callable;
+            Callable callable;
         };
 
-        template < class T >
-        constexpr T* get_constexpr_function_data_as(constexpr_function_storage_t* ptr) noexcept {
-            return static_cast< constexpr_function_data_t< T >* >(ptr)->callable;
-        }
-        template < class T >
-        constexpr T* get_constexpr_function_data_as(const constexpr_function_storage_t* ptr) noexcept {
-            return static_cast< const constexpr_function_data_t< T >* >(ptr)->callable;
-        }
+        // Heap node shared between copies
+        struct constexpr_function_shared_t : constexpr_function_storage_t {
+            using count_type = std::size_t;
+
+            alignas(std::atomic_ref< count_type >::required_alignment) count_type refs { 1 };
+        };
+
+        template < class Callable >
+        struct constexpr_function_shared_data_t : constexpr_function_shared_t {
+            template < class... Args >
+            constexpr explicit constexpr_function_shared_data_t(Args&&... args) :
+                callable(std::forward< Args >(args)...) {
+            }
+
+            Callable callable;
+        };
+
+        template < class Ownership, class Callable >
+        using constexpr_function_node_t = std::conditional_t< Ownership::is_shared,
+                                                              constexpr_function_shared_data_t< Callable >,
+                                                              constexpr_function_data_t< Callable > >;
 
         enum class constexpr_function_op : int
         {
             Copy,
-            Get_fn_ptr,
+            Clone,
+            Move,
             Destroy,
         };
 
-        class constexpr_function_base {
-            using DoFn     = bool (*)(const constexpr_function_base&, constexpr_function_base&, constexpr_function_op);
-            using TypeIdFn = const std::uint8_t* (*)();
+        // Storage of an erased callable and the operations on it, which only take the callable type
+        template < class Storage, class Ownership >
+        class basic_constexpr_function_storage {
+            union storage_t {
+                constexpr_function_storage_t* ptr { nullptr };
+                alignas(Storage::align) unsigned char buffer[Storage::size != 0 ? Storage::size : 1];
+            };
+
+            template < class Callable >
+            using node_t = constexpr_function_node_t< Ownership, Callable >;
 
           public:
-            constexpr constexpr_function_base() noexcept = default;
+            using DoFn     = bool (*)(const basic_constexpr_function_storage&, basic_constexpr_function_storage&,
+                                      constexpr_function_op);
+            using TypeIdFn = const std::uint8_t* (*)();
+
+            constexpr basic_constexpr_function_storage() noexcept = default;
 
-            constexpr ~constexpr_function_base() noexcept {
+            constexpr ~basic_constexpr_function_storage() noexcept {
             }
 
-            inline constexpr bool is_empty() const noexcept {
-                return !static_cast< bool >(data);
+            template < class Callable >
+            static constexpr bool is_inline() noexcept {
+                return !std::is_constant_evaluated() && Storage::template stores_inline_v< Callable >;
             }
 
-            template < class Callable, class F >
-            static constexpr void init(constexpr_function_base& In, F&& Fn) {
-                constexpr_function_base::create< Callable >(In, std::forward< F >(Fn));
+            template < class Callable, class... Args >
+            static constexpr void init(basic_constexpr_function_storage& In, Args&&... args) {
+                basic_constexpr_function_storage::create< Callable >(In, std::forward< Args >(args)...);
             }
 
+            // Run-time thunks of Callable, shared with the other callables of its layout when it shares thunks
             template < class Callable >
-            static constexpr Callable* get_function_pointer(constexpr_function_base& In) noexcept {
-                return get_constexpr_function_data_as< Callable >(In.data);
+            static constexpr DoFn Do_op_of() noexcept {
+                if constexpr (constexpr_function_shares_thunks_v< Callable >) {
+                    if (!std::is_constant_evaluated()) {
+                        return &Do_op< constexpr_function_layout_of_t< Callable > >;
+                    }
+                }
+                return &Do_op< Callable >;
             }
+
             template < class Callable >
-            static constexpr Callable* get_function_pointer(const constexpr_function_base& In) noexcept {
-                return get_constexpr_function_data_as< Callable >(In.data);
+            static constexpr Callable* get_function_pointer(basic_constexpr_function_storage& In) noexcept {
+                if constexpr (constexpr_function_shares_thunks_v< Callable >) {
+                    if (!std::is_constant_evaluated()) {
+                        using Layout = constexpr_function_layout_of_t< Callable >;
+                        return std::launder(reinterpret_cast< Callable* >(get_function_pointer< Layout >(In)->bytes));
+                    }
+                }
+                if (is_inline< Callable >()) {
+                    return std::launder(reinterpret_cast< Callable* >(In.data.buffer));
+                }
+                return std::addressof(static_cast< node_t< Callable >* >(In.data.ptr)->callable);
             }
-
-            template < class Callable, class Fn >
-            static constexpr void create(constexpr_function_base& In, Fn&& In_callable) {
-                constexpr_function_base::finalize< Callable >(In);
-                In.data = new constexpr_function_data_t< Callable > { std::forward< Fn >(In_callable) };
+            template < class Callable >
+            static constexpr Callable* get_function_pointer(const basic_constexpr_function_storage& In) noexcept {
+                // mr::function invokes its target through a const reference, like std::function
+                return get_function_pointer< Callable >(const_cast< basic_constexpr_function_storage& >(In));
             }
 
-            template < class Callable >
-            static constexpr void destroy(constexpr_function_base& In) {
-                finalize< Callable >(In);
+            template < class Callable, class... Args >
+            static constexpr void create(basic_constexpr_function_storage& In, Args&&... args) {
+                if constexpr (constexpr_function_shares_thunks_v< Callable >) {
+                    if (!std::is_constant_evaluated()) {
+                        using Layout = constexpr_function_layout_of_t< Callable >;
+                        create< Layout >(In);
+                        ::new (static_cast< void* >(get_function_pointer< Layout >(In)->bytes))
+                            Callable(std::forward< Args >(args)...);
+                        return;
+                    }
+                }
+                if (is_inline< Callable >()) {
+                    ::new (static_cast< void* >(In.data.buffer)) Callable(std::forward< Args >(args)...);
+                } else {
+                    In.data.ptr = new node_t< Callable >(std::forward< Args >(args)...);
+                    count_erasure< Callable >(erasure_event::Allocation);
+                }
             }
 
             template < class Callable >
-            static constexpr void finalize(constexpr_function_base& In) {
-                if (!In.is_empty()) {
-                    delete static_cast< constexpr_function_data_t< Callable >* >(In.data);
+            static constexpr void destroy(basic_constexpr_function_storage& In) {
+                if constexpr (constexpr_function_shares_thunks_v< Callable >) {
+                    if (!std::is_constant_evaluated()) {
+                        destroy< constexpr_function_layout_of_t< Callable > >(In);
+                        return;
+                    }
+                }
+                if (is_inline< Callable >()) {
+                    std::destroy_at(get_function_pointer< Callable >(In));
+                } else if constexpr (Ownership::is_shared) {
+                    using RefCount = typename Ownership::refcount_type;
+
+                    auto* Node = static_cast< node_t< Callable >* >(std::exchange(In.data.ptr, nullptr));
+                    if (RefCount::decrement(Node->refs)) {
+                        delete Node;
+                        count_erasure< Callable >(erasure_event::Free);
+                    }
+                } else {
+                    delete static_cast< node_t< Callable >* >(std::exchange(In.data.ptr, nullptr));
+                    count_erasure< Callable >(erasure_event::Free);
                 }
             }
 
+            // Number of owners of a shared node
+            static constexpr std::size_t use_count(const basic_constexpr_function_storage& In) noexcept {
+                static_assert(Ownership::is_shared, "use_count requires shared ownership");
+                using RefCount = typename Ownership::refcount_type;
+
+                return RefCount::load(static_cast< const constexpr_function_shared_t* >(In.data.ptr)->refs);
+            }
+
+            // Copy shares the node under shared ownership, Clone always copies the callable, neither exists for
+            // move-only ownership. Move is only requested for rvalue sources, which are left without a callable.
             template < class Callable >
-            static constexpr bool Do_op(const constexpr_function_base& In, constexpr_function_base& Output,
-                                        constexpr_function_op Op) {
+            static constexpr bool Do_op(const basic_constexpr_function_storage& In,
+                                        basic_constexpr_function_storage& Output, constexpr_function_op Op) {
                 switch (Op) {
                     case constexpr_function_op::Copy:
-                        constexpr_function_base::create< Callable >(
-                            Output, *get_constexpr_function_data_as< Callable >(In.data));
+                        count_erasure< Callable >(erasure_event::Copy);
+                        if constexpr (Ownership::is_shared) {
+                            using RefCount = typename Ownership::refcount_type;
+
+                            Output.data.ptr = In.data.ptr;
+                            RefCount::increment(static_cast< constexpr_function_shared_t* >(Output.data.ptr)->refs);
+                        } else if constexpr (Ownership::is_copyable) {
+                            basic_constexpr_function_storage::create< Callable >(Output,
+                                                                              *get_function_pointer< Callable >(In));
+                        } else {
+                            return false;
+                        }
                         break;
-                    case constexpr_function_op::Destroy:
-                        constexpr_function_base::destroy< Callable >(Output);
+                    case constexpr_function_op::Clone:
+                        count_erasure< Callable >(erasure_event::Copy);
+                        if constexpr (Ownership::is_copyable) {
+                            basic_constexpr_function_storage::create< Callable >(Output,
+                                                                              *get_function_pointer< Callable >(In));
+                        } else {
+                            return false;
+                        }
                         break;
-                    case constexpr_function_op::Get_fn_ptr:
-                        Output.data = In.data;
+                    case constexpr_function_op::Move: {
+                        count_erasure< Callable >(erasure_event::Move);
+                        auto& Source = const_cast< basic_constexpr_function_storage& >(In);
+                        if (is_inline< Callable >()) {
+                            basic_constexpr_function_storage::create< Callable >(
+                                Output, std::move(*get_function_pointer< Callable >(Source)));
+                            basic_constexpr_function_storage::destroy< Callable >(Source);
+                        } else {
+                            Output.data.ptr = std::exchange(Source.data.ptr, nullptr);
+                        }
+                        break;
+                    }
+                    case constexpr_function_op::Destroy:
+                        basic_constexpr_function_storage::destroy< Callable >(Output);
                         break;
                     default:
                         return false;
@@ -137,6 +406,7 @@ namespace mr {
                 return true;
             }
 
+            // Shared by every policy, so target() identifies the callable type regardless of the layout
             template < class Callable >
             static constexpr const std::uint8_t* GetTypeID() noexcept {
                 return std::addressof(constexpr_function_data_t< Callable >::Type_id);
@@ -152,33 +422,57 @@ namespace mr {
                 return Fn == nullptr;
             }
 
-            template < class F >
+            template < class F, std::enable_if_t< !is_basic_function_v< F >, int > = 0 >
             static constexpr bool is_null_function(const F& Fn) {
                 (void)Fn;
                 return false;
             }
 
-            template < class F, std::enable_if_t< is_specialization_of_v< F, function >, int > = 0 >
+            template < class F, std::enable_if_t< is_basic_function_v< F >, int > = 0 >
             static constexpr bool is_null_function(const F& Fn) {
                 return !static_cast< bool >(Fn);
             }
 
-            constexpr_function_storage_t* data { nullptr };
-            DoFn                          do_op { nullptr };
-            TypeIdFn                      get_typeId { nullptr };
+            storage_t data {};
         };
 
-        template < class Ret, class... Args >
-        class constexpr_function_impl : public constexpr_function_base {
+        // The storage and the operations of the held callable. Types reaching the operations through their own
+        // table keep only a basic_constexpr_function_storage.
+        template < class Storage, class Ownership >
+        class basic_constexpr_function_base : public basic_constexpr_function_storage< Storage, Ownership > {
+            using Raw_storage = basic_constexpr_function_storage< Storage, Ownership >;
+
+          public:
+            using typename Raw_storage::DoFn;
+            using typename Raw_storage::TypeIdFn;
+
+            inline constexpr bool is_empty() const noexcept {
+                return !static_cast< bool >(do_op);
+            }
+
+            DoFn     do_op { nullptr };
+            TypeIdFn get_typeId { nullptr };
+        };
+
+        using constexpr_function_storage = basic_constexpr_function_storage< sbo_storage<>, unique_ownership >;
+        using constexpr_function_base    = basic_constexpr_function_base< sbo_storage<>, unique_ownership >;
+
+        template < class Storage, class Ownership, class Ret, class... Args >
+        class constexpr_function_impl : public basic_constexpr_function_base< Storage, Ownership > {
           private:
-            using Base    = constexpr_function_base;
-            using Call_fn = Ret (*)(const constexpr_function_base*, Args&&...);
+            using Base    = basic_constexpr_function_base< Storage, Ownership >;
+            using Call_fn = Ret (*)(const Base*, Args&&...);
+
+            // A shared callable is reachable from every copy, so it is only ever invoked as const
+            template < class Callable >
+            using invoked_t = std::conditional_t< Ownership::is_shared, const Callable&, Callable& >;
 
           public:
             template < class T, class U >
             static constexpr bool is_valid_v =
-                std::conjunction_v< std::negation< std::is_same< std::decay_t< T >, U > >,
-                                    std::is_invocable_r< Ret, T, Args... > >;
+                std::conjunction_v< std::negation< std::is_base_of< U, std::decay_t< T > > >,
+                                    std::is_invocable_r< Ret, T, Args... >,
+                                    std::is_invocable_r< Ret, invoked_t< std::decay_t< T > >, Args... > >;
 
             template < class Callable >
             using constexpr_func_impl_callable_t = std::decay_t< Callable >;
@@ -187,134 +481,160 @@ namespace mr {
 
             template < class Callable >
             static constexpr Ret Do_call(const Base* In, Args&&... Types) {
-                Callable& callable = *Base::get_function_pointer< Callable >(*In);
-                return std::invoke(callable, std::forward< Args >(Types)...);
+                count_erasure< Callable >(erasure_event::Call);
+                invoked_t< Callable > callable = *Base::template get_function_pointer< Callable >(*In);
+                if constexpr (std::is_void_v< Ret >) {
+                    std::invoke(callable, std::forward< Args >(Types)...);
+                } else {
+                    return std::invoke(callable, std::forward< Args >(Types)...);
+                }
+            }
+
+            // Call thunk of an empty function, calls need no emptiness check. Throws std::bad_function_call, or
+            // terminates when exceptions are disabled.
+            static constexpr Ret Do_empty_call(const Base*, Args&&...) {
+                throw_or_terminate< std::bad_function_call >();
             }
 
             constexpr Ret operator()(Args... Types) const {
                 return call(this, std::forward< Args >(Types)...);
             }
 
-            Call_fn call { nullptr };
+            // True when the target is a Callable, the same check as target(): both compare the Type_id address the
+            // get_typeId thunk returns. The thunk's own address is not unique across shared libraries.
+            template < class Callable >
+            constexpr bool holds() const noexcept {
+                return !this->is_empty() &&
+                       this->get_typeId() == Base::template GetTypeID< constexpr_func_impl_callable_t< Callable > >();
+            }
+
+            // Guarded devirtualization: a direct call of the Callable thunk, which the compiler can inline, when the
+            // target is a Callable, the erased call otherwise
+            template < class Callable >
+            constexpr Ret invoke_as(Args... Types) const {
+                if (holds< Callable >()) {
+                    return Do_call< std::decay_t< Callable > >(this, std::forward< Args >(Types)...);
+                }
+                return call(this, std::forward< Args >(Types)...);
+            }
+
+            Call_fn call { &Do_empty_call };
         };
 
-        template < class NotFn >
+        template < class NotFn, class Storage, class Ownership >
         struct get_constexpr_function_base {
             static_assert(Eval_function_to_false< NotFn >,
                           "Incorrect behaviour: non-function type was passed to mr::function!");
         };
-        template < class Ret, class... Args >
-        struct get_constexpr_function_base< Ret(Args...) > {
-            using type = constexpr_function_impl< Ret, Args... >;
+        template < class Ret, class... Args, class Storage, class Ownership >
+        struct get_constexpr_function_base< Ret(Args...), Storage, Ownership > {
+            using type = constexpr_function_impl< Storage, Ownership, Ret, Args... >;
         };
-        template < class Ret, class... Args >
-        struct get_constexpr_function_base< Ret(Args...) noexcept > {
+        template < class Ret, class... Args, class Storage, class Ownership >
+        struct get_constexpr_function_base< Ret(Args...) noexcept, Storage, Ownership > {
             static_assert(Eval_function_to_false< Ret(Args...) noexcept >,
                           "Incorrect behaviour: noexcept type was passed to mr::function!");
         };
 
-        namespace {
-
-            template < class T >
-            struct get_memfun_ptr_deduction {};
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) > {
-                using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...)& > {
-                using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) && > {
-                using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const > {
-                using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const& > {
-                using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const&& > {
-                using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const volatile > {
-                using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const volatile& > {
-                using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const volatile&& > {
-                using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) volatile > {
-                using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) volatile& > {
-                using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) volatile&& > {
-                using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) noexcept > {
-                using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...)& noexcept > {
-                using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...)&& noexcept > {
-                using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const noexcept > {
-                using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const& noexcept > {
-                using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const&& noexcept > {
-                using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const volatile noexcept > {
-                using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const volatile& noexcept > {
-                using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const volatile&& noexcept > {
-                using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) volatile noexcept > {
-                using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) volatile& noexcept > {
-                using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
-            };
-            template < class Ret, class TClass, class... Args >
-            struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) volatile&& noexcept > {
-                using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
-            };
-
-        } // namespace
+        // Signature of a call operator, for the deduction guides
+        template < class T >
+        struct get_memfun_ptr_deduction {};
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) > {
+            using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...)& > {
+            using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) && > {
+            using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const > {
+            using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const& > {
+            using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const&& > {
+            using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const volatile > {
+            using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const volatile& > {
+            using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const volatile&& > {
+            using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) volatile > {
+            using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) volatile& > {
+            using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) volatile&& > {
+            using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) noexcept > {
+            using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...)& noexcept > {
+            using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...)&& noexcept > {
+            using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const noexcept > {
+            using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const& noexcept > {
+            using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const&& noexcept > {
+            using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const volatile noexcept > {
+            using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const volatile& noexcept > {
+            using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) const volatile&& noexcept > {
+            using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) volatile noexcept > {
+            using guide_type = std::enable_if< !std::is_same_v< int, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) volatile& noexcept > {
+            using guide_type = std::enable_if< !std::is_same_v< int&, int&& >, Ret(Args...) >;
+        };
+        template < class Ret, class TClass, class... Args >
+        struct get_memfun_ptr_deduction< Ret (TClass::*)(Args...) volatile&& noexcept > {
+            using guide_type = std::enable_if< !std::is_same_v< int&&, int&& >, Ret(Args...) >;
+        };
 
         template < class F, class = void >
         struct constexpr_function_deduce {}; // Invalid deduction
@@ -324,144 +644,400 @@ namespace mr {
 
     } // namespace detail
 
-    template < class F >
-    class function : protected detail::get_constexpr_function_base< F >::type {
-        using Base = typename detail::get_constexpr_function_base< F >::type;
+    // Erased callable of signature F. Storage picks where the callable lives (mr::sbo_storage, mr::heap_storage,
+    // mr::inline_storage) and Ownership what a copy means (mr::unique_ownership, mr::shared_ownership).
+    template < class F, class Storage, class Ownership >
+    class basic_function : protected detail::get_constexpr_function_base< F, Storage, Ownership >::type {
+        using Base     = typename detail::get_constexpr_function_base< F, Storage, Ownership >::type;
+        using Raw_base = detail::basic_constexpr_function_base< Storage, Ownership >;
+
+        static_assert(!Ownership::is_shared || std::is_same_v< Storage, heap_storage >,
+                      "Incorrect behaviour: shared ownership requires mr::heap_storage!");
+
+        template < class Callable, class... CtorArgs >
+        static constexpr bool is_emplaceable_v =
+            std::conjunction_v< std::is_constructible< std::decay_t< Callable >, CtorArgs... >,
+                                std::bool_constant< Base::template is_valid_v< std::decay_t< Callable >,
+                                                                               basic_function > > >;
 
       public:
-        using result_type = typename Base::Res;
+        using result_type    = typename Base::Res;
+        using storage_type   = Storage;
+        using ownership_type = Ownership;
 
         using Base::operator();
+        using Base::holds;
+        using Base::invoke_as;
 
-        constexpr function() noexcept {};
+        constexpr basic_function() noexcept {};
 
-        constexpr function(std::nullptr_t) noexcept {};
+        constexpr basic_function(std::nullptr_t) noexcept {};
 
-        constexpr function(const function& Val) {
+        constexpr basic_function(const basic_function& Val) noexcept(Ownership::is_shared)
+            requires(Ownership::is_copyable)
+        {
             if (static_cast< bool >(Val)) {
-                Val.do_op(*static_cast< const detail::constexpr_function_base* >(std::addressof(Val)),
-                          *static_cast< detail::constexpr_function_base* >(this), detail::constexpr_function_op::Copy);
+                Val.do_op(*static_cast< const Raw_base* >(std::addressof(Val)), *static_cast< Raw_base* >(this),
+                          detail::constexpr_function_op::Copy);
                 Base::do_op      = Val.do_op;
                 Base::call       = Val.call;
                 Base::get_typeId = Val.get_typeId;
             }
         }
 
-        constexpr function(function&& Val) noexcept {
-            Base::call       = std::exchange(Val.call, nullptr);
-            Base::do_op      = std::exchange(Val.do_op, nullptr);
-            Base::get_typeId = std::exchange(Val.get_typeId, nullptr);
-            Base::data       = std::exchange(Val.data, nullptr);
+        constexpr basic_function(basic_function&& Val) noexcept {
+            move_from(Val);
         }
 
-        template < class Callable, std::enable_if_t< Base::template is_valid_v< Callable, function< F > >, int > = 0 >
-        constexpr function(Callable&& Val) {
-            static_assert(std::is_copy_constructible_v< std::decay_t< Callable > >,
-                          "Callable must be copy-constructible");
+        template < class Callable, std::enable_if_t< Base::template is_valid_v< Callable, basic_function >, int > = 0 >
+        constexpr basic_function(Callable&& Val) {
             static_assert(std::is_constructible_v< std::decay_t< Callable >, Callable >,
                           "Callable must be constructible from itself");
 
             using Callable_t = typename Base::template constexpr_func_impl_callable_t< Callable >;
-
-            if (!detail::constexpr_function_base::is_null_function< Callable_t >(Val)) {
-                detail::constexpr_function_base::init< Callable_t >(
-                    *static_cast< detail::constexpr_function_base* >(this), std::forward< Callable >(Val));
-                Base::do_op      = detail::constexpr_function_base::template Do_op< Callable_t >;
-                Base::call       = Base::template Do_call< Callable_t >;
-                Base::get_typeId = Base::template GetTypeID< Callable_t >;
+            if (!Raw_base::is_null_function(Val)) {
+                construct< Callable_t >(std::forward< Callable >(Val));
             }
         }
 
-        constexpr ~function() {
-            if (!Base::is_empty()) {
-                Base::do_op(*this, *this, detail::constexpr_function_op::Destroy);
-                Base::call       = nullptr;
-                Base::data       = nullptr;
-                Base::do_op      = nullptr;
-                Base::get_typeId = nullptr;
-            }
+        // Builds the callable from args directly in its storage, without a temporary to move from
+        template < class Callable, class... CtorArgs,
+                   std::enable_if_t< is_emplaceable_v< Callable, CtorArgs... >, int > = 0 >
+        constexpr explicit basic_function(std::in_place_type_t< Callable >, CtorArgs&&... args) {
+            construct< std::decay_t< Callable > >(std::forward< CtorArgs >(args)...);
         }
 
-        constexpr function& operator=(const function& Val) {
-            function(Val).swap(*this);
-            return *this;
+        template < class Callable, class Elem, class... CtorArgs,
+                   std::enable_if_t< is_emplaceable_v< Callable, std::initializer_list< Elem >&, CtorArgs... >,
+                                     int > = 0 >
+        constexpr explicit basic_function(std::in_place_type_t< Callable >, std::initializer_list< Elem > il,
+                                          CtorArgs&&... args) {
+            construct< std::decay_t< Callable > >(il, std::forward< CtorArgs >(args)...);
+        }
+
+        constexpr ~basic_function() {
+            reset();
         }
 
-        constexpr function& operator=(function&& Val) noexcept {
-            Val.swap(*this);
+        constexpr basic_function& operator=(const basic_function& Val) noexcept(Ownership::is_shared)
+            requires(Ownership::is_copyable)
+        {
+            basic_function(Val).swap(*this);
             return *this;
         }
 
-        constexpr function& operator=(std::nullptr_t) noexcept {
-            if (!Base::is_empty()) {
-                Base::do_op(*static_cast< detail::constexpr_function_base* >(this),
-                            *static_cast< detail::constexpr_function_base* >(this),
-                            detail::constexpr_function_op::Destroy);
-                Base::do_op      = nullptr;
-                Base::call       = nullptr;
-                Base::get_typeId = nullptr;
+        constexpr basic_function& operator=(basic_function&& Val) noexcept {
+            if (this != std::addressof(Val)) {
+                reset();
+                move_from(Val);
             }
             return *this;
         }
 
-        template < class Callable, std::enable_if_t< Base::template is_valid_v< Callable, function >, int > = 0 >
-        constexpr function& operator=(Callable&& Val) {
-            function(std::forward< Callable >(Val)).swap(*this);
+        constexpr basic_function& operator=(std::nullptr_t) noexcept {
+            reset();
+            return *this;
+        }
+
+        template < class Callable, std::enable_if_t< Base::template is_valid_v< Callable, basic_function >, int > = 0 >
+        constexpr basic_function& operator=(Callable&& Val) {
+            basic_function(std::forward< Callable >(Val)).swap(*this);
             return *this;
         }
 
         template < class Callable >
-        constexpr function& operator=(std::reference_wrapper< Callable > Val) noexcept {
-            function(Val).swap(*this);
+        constexpr basic_function& operator=(std::reference_wrapper< Callable > Val) noexcept {
+            basic_function(Val).swap(*this);
             return *this;
         }
 
-        constexpr void swap(function& Val) noexcept {
-            std::swap(Base::data, Val.data);
-            std::swap(Base::do_op, Val.do_op);
-            std::swap(Base::get_typeId, Val.get_typeId);
-            std::swap(Base::call, Val.call);
+        // Replaces the target with a callable built from args in its storage. The old target is destroyed first,
+        // the function is left empty when the construction throws.
+        template < class Callable, class... CtorArgs,
+                   std::enable_if_t< is_emplaceable_v< Callable, CtorArgs... >, int > = 0 >
+        constexpr std::decay_t< Callable >& emplace(CtorArgs&&... args) {
+            reset();
+            return construct< std::decay_t< Callable > >(std::forward< CtorArgs >(args)...);
+        }
+
+        template < class Callable, class Elem, class... CtorArgs,
+                   std::enable_if_t< is_emplaceable_v< Callable, std::initializer_list< Elem >&, CtorArgs... >,
+                                     int > = 0 >
+        constexpr std::decay_t< Callable >& emplace(std::initializer_list< Elem > il, CtorArgs&&... args) {
+            reset();
+            return construct< std::decay_t< Callable > >(il, std::forward< CtorArgs >(args)...);
+        }
+
+        constexpr void swap(basic_function& Val) noexcept {
+            if (this != std::addressof(Val)) {
+                basic_function Tmp { std::move(Val) };
+                Val.move_from(*this);
+                move_from(Tmp);
+            }
         }
 
         constexpr explicit operator bool() const noexcept {
             return !Base::is_empty();
         }
 
+        // Under shared ownership, mutable access first detaches a private copy of a shared callable
         template < typename Callable >
-        constexpr Callable* target() noexcept {
-            const function* C_function = this;
-            const Callable* Fn         = C_function->template target< Callable >();
+        constexpr Callable* target() noexcept(!Ownership::is_shared) {
+            const basic_function* C_function = this;
+            const Callable*       Fn         = C_function->template target< Callable >();
+            if constexpr (Ownership::is_shared) {
+                if (Fn && use_count() != 1) {
+                    detach();
+                    Fn = C_function->template target< Callable >();
+                }
+            }
             return *const_cast< Callable** >(&Fn);
         }
 
         template < typename Callable >
         constexpr const Callable* target() const noexcept {
             using Callable_t = typename Base::template constexpr_func_impl_callable_t< Callable >;
-            if (Base::get_typeId() == Base::template GetTypeID< Callable_t >() && !Base::is_empty()) {
-                detail::constexpr_function_base Res {};
-                Base::do_op(*static_cast< detail::constexpr_function_base* >(const_cast< function< F >* >(this)), Res,
-                            detail::constexpr_function_op::Get_fn_ptr);
-                return detail::get_constexpr_function_data_as< Callable >(
-                    static_cast< const detail::constexpr_function_storage_t* >(Res.data));
+            if (!Base::is_empty() && Base::get_typeId() == Base::template GetTypeID< Callable_t >()) {
+                detail::count_erasure< Callable_t >(detail::erasure_event::Cast_hit);
+                return Raw_base::template get_function_pointer< Callable_t >(*static_cast< const Raw_base* >(this));
             }
+            detail::count_erasure< Callable_t >(detail::erasure_event::Cast_miss);
             return nullptr;
         }
+
+        // Number of objects sharing the callable, 0 when empty
+        template < class O = Ownership, std::enable_if_t< O::is_shared, int > = 0 >
+        [[nodiscard]] constexpr std::size_t use_count() const noexcept {
+            return Base::is_empty() ? 0 : Raw_base::use_count(*this);
+        }
+
+      private:
+        // Expects *this to be empty
+        template < class Callable, class... CtorArgs >
+        constexpr Callable& construct(CtorArgs&&... args) {
+            static_assert(!Ownership::is_copyable || std::is_copy_constructible_v< Callable >,
+                          "Callable must be copy-constructible");
+            static_assert(Storage::heap_fallback || Storage::template stores_inline_v< Callable >,
+                          "Callable does not fit the inline storage of this mr::basic_function");
+
+            Raw_base::template init< Callable >(*static_cast< Raw_base* >(this), std::forward< CtorArgs >(args)...);
+            Base::do_op      = Raw_base::template Do_op_of< Callable >();
+            Base::call       = Base::template Do_call< Callable >;
+            Base::get_typeId = Base::template GetTypeID< Callable >;
+            return *Raw_base::template get_function_pointer< Callable >(*static_cast< Raw_base* >(this));
+        }
+
+        constexpr void reset() noexcept {
+            if (!Base::is_empty()) {
+                Base::do_op(*this, *this, detail::constexpr_function_op::Destroy);
+                Base::call       = &Base::Do_empty_call;
+                Base::do_op      = nullptr;
+                Base::get_typeId = nullptr;
+            }
+        }
+
+        // Expects *this to be empty, Val is left empty
+        constexpr void move_from(basic_function& Val) noexcept {
+            if (!Val.is_empty()) {
+                Val.do_op(*static_cast< const Raw_base* >(std::addressof(Val)), *static_cast< Raw_base* >(this),
+                          detail::constexpr_function_op::Move);
+                Base::call       = std::exchange(Val.call, &Base::Do_empty_call);
+                Base::do_op      = std::exchange(Val.do_op, nullptr);
+                Base::get_typeId = std::exchange(Val.get_typeId, nullptr);
+            }
+        }
+
+        constexpr void detach() {
+            basic_function Detached {};
+            Base::do_op(*this, Detached, detail::constexpr_function_op::Clone);
+            Detached.do_op      = Base::do_op;
+            Detached.call       = Base::call;
+            Detached.get_typeId = Base::get_typeId;
+            Detached.swap(*this);
+        }
+    };
+
+    // basic_function with the default policies. A class rather than an alias template so that class template
+    // argument deduction works on compilers without deduction through alias templates.
+    template < class F >
+    class function : public basic_function< F > {
+        using Base = basic_function< F >;
+
+      public:
+        using Base::Base;
+        using Base::operator=;
+
+        constexpr function() noexcept = default;
+
+        constexpr function(const Base& Val) : Base(Val) {
+        }
+
+        constexpr function(Base&& Val) noexcept : Base(std::move(Val)) {
+        }
     };
 
     // Deduction guide
+    template < class Ret, class... Args >
+    basic_function(Ret (*)(Args...)) -> basic_function< Ret(Args...) >;
+    template < class F >
+    basic_function(F) -> basic_function< typename detail::constexpr_function_deduce< F >::type >;
+
     template < class Ret, class... Args >
     function(Ret (*)(Args...)) -> function< Ret(Args...) >;
     template < class F >
     function(F) -> function< typename detail::constexpr_function_deduce< F >::type >;
 
-    template < class Ret, class... Args >
-    void swap(function< Ret(Args...) >& lhs, function< Ret(Args...) >& rhs) noexcept {
+    template < class F, class Callable, class... Args >
+    [[nodiscard]] constexpr function< F > make_function(Args&&... args) {
+        return function< F > { std::in_place_type< Callable >, std::forward< Args >(args)... };
+    }
+
+    template < class F, class Callable, class Elem, class... Args >
+    [[nodiscard]] constexpr function< F > make_function(std::initializer_list< Elem > il, Args&&... args) {
+        return function< F > { std::in_place_type< Callable >, il, std::forward< Args >(args)... };
+    }
+
+    template < class F, class Storage, class Ownership >
+    constexpr void swap(basic_function< F, Storage, Ownership >& lhs,
+                        basic_function< F, Storage, Ownership >& rhs) noexcept {
         lhs.swap(rhs);
     }
 
-    template < class Ret, class... Args >
-    bool operator==(const function< Ret(Args...) >& F, std::nullptr_t) noexcept {
-        return !static_cast< bool >(F);
+    template < class F, class Storage, class Ownership >
+    constexpr bool operator==(const basic_function< F, Storage, Ownership >& Fn, std::nullptr_t) noexcept {
+        return !static_cast< bool >(Fn);
+    }
+
+    namespace detail {
+
+        // Result of mr::bind_front / mr::bind_back. The bound arguments are stored by value next to the target, so
+        // erasing a binding into mr::function is one storage block, kept inline when it is small enough.
+        template < bool Front, class Fn, class... Bound >
+        class constexpr_binder {
+            using Indices = std::index_sequence_for< Bound... >;
+
+            template < class F, class Tuple, std::size_t... I, class... Args >
+            static constexpr auto call(std::true_type, F&& Target, Tuple&& Values, std::index_sequence< I... >,
+                                       Args&&... args)
+                -> decltype(std::invoke(std::forward< F >(Target), std::get< I >(std::forward< Tuple >(Values))...,
+                                        std::forward< Args >(args)...)) {
+                return std::invoke(std::forward< F >(Target), std::get< I >(std::forward< Tuple >(Values))...,
+                                   std::forward< Args >(args)...);
+            }
+
+            template < class F, class Tuple, std::size_t... I, class... Args >
+            static constexpr auto call(std::false_type, F&& Target, Tuple&& Values, std::index_sequence< I... >,
+                                       Args&&... args)
+                -> decltype(std::invoke(std::forward< F >(Target), std::forward< Args >(args)...,
+                                        std::get< I >(std::forward< Tuple >(Values))...)) {
+                return std::invoke(std::forward< F >(Target), std::forward< Args >(args)...,
+                                   std::get< I >(std::forward< Tuple >(Values))...);
+            }
+
+            template < class F, class Tuple, class... Args >
+            using call_result_t = decltype(call(std::bool_constant< Front > {}, std::declval< F >(),
+                                                std::declval< Tuple >(), Indices {}, std::declval< Args >()...));
+
+            using Bound_t = std::tuple< Bound... >;
+
+          public:
+            template < class F, class... Bs >
+            constexpr explicit constexpr_binder(std::in_place_t, F&& Target, Bs&&... Values) :
+                fn(std::forward< F >(Target)), bound(std::forward< Bs >(Values)...) {
+            }
+
+            template < class... Args >
+            constexpr call_result_t< Fn&, Bound_t&, Args... > operator()(Args&&... args) & {
+                return call(std::bool_constant< Front > {}, fn, bound, Indices {}, std::forward< Args >(args)...);
+            }
+
+            template < class... Args >
+            constexpr call_result_t< const Fn&, const Bound_t&, Args... > operator()(Args&&... args) const& {
+                return call(std::bool_constant< Front > {}, fn, bound, Indices {}, std::forward< Args >(args)...);
+            }
+
+            template < class... Args >
+            constexpr call_result_t< Fn, Bound_t, Args... > operator()(Args&&... args) && {
+                return call(std::bool_constant< Front > {}, std::move(fn), std::move(bound), Indices {},
+                            std::forward< Args >(args)...);
+            }
+
+            template < class... Args >
+            constexpr call_result_t< const Fn, const Bound_t, Args... > operator()(Args&&... args) const&& {
+                return call(std::bool_constant< Front > {}, std::move(fn), std::move(bound), Indices {},
+                            std::forward< Args >(args)...);
+            }
+
+            [[nodiscard]] constexpr const Fn& get_target() const& noexcept {
+                return fn;
+            }
+
+            [[nodiscard]] constexpr Fn&& get_target() && noexcept {
+                return std::move(fn);
+            }
+
+            [[nodiscard]] constexpr const std::tuple< Bound... >& get_bound() const& noexcept {
+                return bound;
+            }
+
+            [[nodiscard]] constexpr std::tuple< Bound... >&& get_bound() && noexcept {
+                return std::move(bound);
+            }
+
+          private:
+            [[no_unique_address]] Fn      fn;
+            [[no_unique_address]] Bound_t bound;
+        };
+
+        template < bool Front, class T >
+        inline constexpr bool is_constexpr_binder_v = false;
+        template < bool Front, class Fn, class... Bound >
+        inline constexpr bool is_constexpr_binder_v< Front, constexpr_binder< Front, Fn, Bound... > > = true;
+
+        template < bool Front, class F, class Tuple >
+        constexpr auto make_binder(F&& Target, Tuple&& Values) {
+            return std::apply(
+                [&](auto&&... Bs) {
+                    return constexpr_binder< Front, std::decay_t< F >, std::decay_t< decltype(Bs) >... > {
+                        std::in_place, std::forward< F >(Target), std::forward< decltype(Bs) >(Bs)...
+                    };
+                },
+                std::forward< Tuple >(Values));
+        }
+
+        // A binding of a binding in the same direction is flattened into one binder around the innermost target
+        template < bool Front, class F, class... Args >
+        constexpr auto bind(F&& Target, Args&&... args) {
+            if constexpr (is_constexpr_binder_v< Front, std::remove_cvref_t< F > >) {
+                // get_target() and get_bound() forward distinct members, Target is not used after a move
+                if constexpr (Front) {
+                    return make_binder< Front >(std::forward< F >(Target).get_target(),
+                                                std::tuple_cat(std::forward< F >(Target).get_bound(),
+                                                               std::forward_as_tuple(std::forward< Args >(args)...)));
+                } else {
+                    return make_binder< Front >(std::forward< F >(Target).get_target(),
+                                                std::tuple_cat(std::forward_as_tuple(std::forward< Args >(args)...),
+                                                               std::forward< F >(Target).get_bound()));
+                }
+            } else {
+                return constexpr_binder< Front, std::decay_t< F >, std::decay_t< Args >... > {
+                    std::in_place, std::forward< F >(Target), std::forward< Args >(args)...
+                };
+            }
+        }
+
+    } // namespace detail
+
+    // bind_front(f, bound...)(args...) == std::invoke(f, bound..., args...)
+    template < class F, class... Args >
+    [[nodiscard]] constexpr auto bind_front(F&& Target, Args&&... args) {
+        return detail::bind< true >(std::forward< F >(Target), std::forward< Args >(args)...);
+    }
+
+    // bind_back(f, bound...)(args...) == std::invoke(f, args..., bound...)
+    template < class F, class... Args >
+    [[nodiscard]] constexpr auto bind_back(F&& Target, Args&&... args) {
+        return detail::bind< false >(std::forward< F >(Target), std::forward< Args >(args)...);
     }
 
 } // namespace mr
@@ -0,0 +1,239 @@
+#if !defined(CONSTEXPR_MEMOIZED_H_INCLUDED_9B582658_84EF_4C56_9D92_11222C7D299E)
+    #define CONSTEXPR_MEMOIZED_H_INCLUDED_9B582658_84EF_4C56_9D92_11222C7D299E
+
+// Memoization of pure erased callables. During constant evaluation results are kept in a table owned by the object,
+// sorted when the arguments are ordered, so repeated calls cost a lookup instead of evaluation steps. At run-time
+// results go to a bounded direct-mapped cache private to the calling thread, or nowhere with mr::no_runtime_cache.
+
+    #include <algorithm>
+    #include <atomic>
+    #include <concepts>
+    #include <constexpr_function.h>
+    #include <cstddef>
+    #include <cstdint>
+    #include <functional>
+    #include <optional>
+    #include <tuple>
+    #include <type_traits>
+    #include <utility>
+    #include <vector>
+
+namespace mr {
+
+    namespace detail {
+
+        // Identifies the callable of a memoized object in the run-time caches shared by every object of its type
+        inline std::atomic< std::uint64_t > memoized_next_id { 1 };
+
+        template < class T >
+        inline std::size_t memoized_hash(std::size_t seed, const T& value) {
+            return seed ^ (std::hash< T > {}(value) + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+        }
+
+        template < class Key >
+        inline std::size_t memoized_hash_key(const Key& key) {
+            return std::apply([](const auto&... values) {
+                std::size_t seed = 0;
+                ((seed = memoized_hash(seed, values)), ...);
+                return seed;
+            }, key);
+        }
+
+        template < class T, class = void >
+        inline constexpr bool is_hashable_v = false;
+        template < class T >
+        inline constexpr bool
+            is_hashable_v< T, std::void_t< decltype(std::hash< T > {}(std::declval< const T& >())) > > = true;
+
+        // Results kept for constant evaluation. Reached through a pointer rather than a mutable member so that const
+        // calls can insert, GCC 12 rejects mutable members in constant evaluation. Only allocated while constant
+        // evaluated.
+        template < class Entry >
+        class memoized_table {
+          public:
+            constexpr memoized_table() {
+                if (std::is_constant_evaluated()) {
+                    entries = new std::vector< Entry > {};
+                }
+            }
+
+            constexpr memoized_table(const memoized_table& Val) :
+                entries(Val.entries ? new std::vector< Entry > { *Val.entries } : nullptr) {
+            }
+
+            constexpr memoized_table(memoized_table&& Val) noexcept : entries(std::exchange(Val.entries, nullptr)) {
+            }
+
+            constexpr memoized_table& operator=(memoized_table Val) noexcept {
+                std::swap(entries, Val.entries);
+                return *this;
+            }
+
+            constexpr ~memoized_table() {
+                delete entries;
+            }
+
+            constexpr std::vector< Entry >& get() const noexcept {
+                return *entries;
+            }
+
+            constexpr std::size_t size() const noexcept {
+                return entries ? entries->size() : 0;
+            }
+
+          private:
+            std::vector< Entry >* entries { nullptr };
+        };
+
+    } // namespace detail
+
+    // Run-time cache policies of mr::memoized
+    // Direct-mapped cache of Slots entries per thread and memoized type, a colliding result replaces the older one
+    template < std::size_t Slots = 256 >
+    struct thread_local_cache {
+        static_assert(Slots != 0, "mr::thread_local_cache requires at least one slot");
+
+        template < class Key, class Ret >
+        class table {
+            struct slot {
+                std::uint64_t                          owner { 0 };
+                std::optional< std::pair< Key, Ret > > entry {};
+            };
+
+          public:
+            const Ret* find(std::uint64_t owner, std::size_t hash, const Key& key) const {
+                const slot& s = slots[hash % Slots];
+                if (s.owner == owner && s.entry && s.entry->first == key) {
+                    return std::addressof(s.entry->second);
+                }
+                return nullptr;
+            }
+
+            void store(std::uint64_t owner, std::size_t hash, Key&& key, const Ret& value) {
+                slot& s = slots[hash % Slots];
+                s.owner = owner;
+                s.entry.emplace(std::move(key), value);
+            }
+
+          private:
+            std::vector< slot > slots = std::vector< slot >(Slots);
+        };
+    };
+
+    // Calls the callable every time at run-time
+    struct no_runtime_cache {};
+
+    template < class Sig, class RuntimeCache = thread_local_cache<> >
+    class memoized;
+
+    // Wraps a pure callable, i.e. one whose result only depends on its arguments. Results are looked up by the
+    // decayed arguments, compared with ==, before the erased callable is invoked.
+    template < class Ret, class... Args, class RuntimeCache >
+    class memoized< Ret(Args...), RuntimeCache > {
+        static_assert(!std::is_void_v< Ret > && !std::is_reference_v< Ret >,
+                      "mr::memoized stores results by value, Ret must be an object type");
+
+        using Key = std::tuple< std::decay_t< Args >... >;
+
+        static constexpr bool Runtime_cache = !std::is_same_v< RuntimeCache, no_runtime_cache >;
+        static constexpr bool Ordered       = (std::totally_ordered< std::decay_t< Args > > && ...);
+
+        static_assert(!Runtime_cache || (detail::is_hashable_v< std::decay_t< Args > > && ...),
+                      "mr::thread_local_cache hashes the arguments, use mr::no_runtime_cache for unhashable ones");
+
+        struct entry {
+            Key key;
+            Ret value;
+        };
+
+      public:
+        constexpr memoized() = default;
+
+        template < class Callable, std::enable_if_t< !std::is_same_v< std::decay_t< Callable >, memoized > &&
+                                                         std::is_invocable_r_v< Ret, Callable&, Args... >,
+                                                     int > = 0 >
+        constexpr memoized(Callable&& Fn) : fn(std::forward< Callable >(Fn)) {
+            if (!std::is_constant_evaluated()) {
+                id = detail::memoized_next_id.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // Copies share the run-time cache entries, they hold the same callable
+        constexpr memoized(const memoized&)            = default;
+        constexpr memoized(memoized&&) noexcept        = default;
+        constexpr memoized& operator=(const memoized&) = default;
+        constexpr memoized& operator=(memoized&&)      = default;
+
+        // The key is only built where it is used, calls without a run-time cache don't copy the arguments
+        constexpr Ret operator()(Args... args) const {
+            if (std::is_constant_evaluated()) {
+                return constant_call(Key { args... }, std::forward< Args >(args)...);
+            }
+            if constexpr (Runtime_cache) {
+                // The owner is part of the hash so that objects of the same type don't evict each other's results
+                Key               key { args... };
+                auto&             cache = runtime_table();
+                const std::size_t hash  = detail::memoized_hash(detail::memoized_hash_key(key), id);
+                if (const Ret* found = cache.find(id, hash, key)) {
+                    return *found;
+                }
+                Ret value = fn(std::forward< Args >(args)...);
+                cache.store(id, hash, std::move(key), value);
+                return value;
+            } else {
+                return fn(std::forward< Args >(args)...);
+            }
+        }
+
+        constexpr explicit operator bool() const noexcept {
+            return static_cast< bool >(fn);
+        }
+
+        // Results kept for constant evaluation, always 0 at run-time
+        [[nodiscard]] constexpr std::size_t constant_entries() const noexcept {
+            return table.size();
+        }
+
+      private:
+        using Runtime_table = typename std::conditional_t< Runtime_cache, RuntimeCache, thread_local_cache< 1 > >::
+            template table< Key, Ret >;
+
+        static Runtime_table& runtime_table() {
+            static thread_local Runtime_table cache {};
+            return cache;
+        }
+
+        constexpr Ret constant_call(Key&& key, Args&&... args) const {
+            std::vector< entry >& entries = table.get();
+            if constexpr (Ordered) {
+                auto it = std::lower_bound(entries.begin(), entries.end(), key,
+                                           [](const entry& e, const Key& k) { return e.key < k; });
+                if (it != entries.end() && it->key == key) {
+                    return it->value;
+                }
+                Ret value = fn(std::forward< Args >(args)...);
+                // The call may have added entries through recursion, the position is searched again
+                it = std::lower_bound(entries.begin(), entries.end(), key,
+                                      [](const entry& e, const Key& k) { return e.key < k; });
+                entries.insert(it, entry { std::move(key), value });
+                return value;
+            } else {
+                for (const entry& e : entries) {
+                    if (e.key == key) {
+                        return e.value;
+                    }
+                }
+                Ret value = fn(std::forward< Args >(args)...);
+                entries.push_back(entry { std::move(key), value });
+                return value;
+            }
+        }
+
+        function< Ret(Args...) >        fn {};
+        std::uint64_t                   id { 0 };
+        detail::memoized_table< entry > table {};
+    };
+
+} // namespace mr
+
+#endif // !defined(CONSTEXPR_MEMOIZED_H_INCLUDED_9B582658_84EF_4C56_9D92_11222C7D299E)
@@ -0,0 +1,218 @@
+#if !defined(CONSTEXPR_OVERLOADED_FUNCTION_H_INCLUDED_B6C9E4C3_36A4_4994_A6CF_CD7CA40D8E2E)
+    #define CONSTEXPR_OVERLOADED_FUNCTION_H_INCLUDED_B6C9E4C3_36A4_4994_A6CF_CD7CA40D8E2E
+
+    #include <constexpr_exceptions.h>
+    #include <constexpr_function.h>
+    #include <cstddef>
+    #include <cstdint>
+    #include <functional>
+    #include <tuple>
+    #include <type_traits>
+    #include <utility>
+
+namespace mr {
+
+    template < class... Sigs >
+    class overloaded_function;
+
+    namespace detail {
+
+        template < class Sig >
+        struct overload_slot {
+            static_assert(Eval_function_to_false< Sig >,
+                          "Incorrect behaviour: non-function type was passed to mr::overloaded_function!");
+        };
+        template < class Ret, class... Args >
+        struct overload_slot< Ret(Args...) > {
+            using type = Ret (*)(const constexpr_function_storage&, Args&&...);
+
+            template < class Callable >
+            static constexpr bool accepts_v = std::is_invocable_r_v< Ret, Callable&, Args... >;
+
+            template < class Callable >
+            static constexpr Ret call(const constexpr_function_storage& In, Args&&... args) {
+                Callable& callable = *constexpr_function_storage::get_function_pointer< Callable >(In);
+                if constexpr (std::is_void_v< Ret >) {
+                    std::invoke(callable, std::forward< Args >(args)...);
+                } else {
+                    return std::invoke(callable, std::forward< Args >(args)...);
+                }
+            }
+        };
+
+        // One table per callable type, shared by every overloaded_function holding that type
+        template < class... Sigs >
+        struct overload_table {
+            bool (*do_op)(const constexpr_function_storage&, constexpr_function_storage&, constexpr_function_op);
+            const std::uint8_t* (*get_typeId)();
+            std::tuple< typename overload_slot< Sigs >::type... > calls;
+        };
+
+        template < class Callable, class... Sigs >
+        inline constexpr overload_table< Sigs... > overload_table_for {
+            &constexpr_function_storage::Do_op< Callable >, &constexpr_function_storage::GetTypeID< Callable >,
+            { &overload_slot< Sigs >::template call< Callable >... }
+        };
+
+        template < class Derived, std::size_t I, class Sig >
+        struct overload_call;
+        template < class Derived, std::size_t I, class Ret, class... Args >
+        struct overload_call< Derived, I, Ret(Args...) > {
+            constexpr Ret operator()(Args... args) const {
+                return static_cast< const Derived& >(*this).template call< I >(std::forward< Args >(args)...);
+            }
+        };
+
+        template < class Derived, class Indices, class... Sigs >
+        struct overload_set;
+        template < class Derived, std::size_t... I, class... Sigs >
+        struct overload_set< Derived, std::index_sequence< I... >, Sigs... > : overload_call< Derived, I, Sigs >... {
+            using overload_call< Derived, I, Sigs >::operator()...;
+        };
+
+        template < class... Sigs >
+        inline constexpr bool are_distinct_v = true;
+        template < class Sig, class... Sigs >
+        inline constexpr bool are_distinct_v< Sig, Sigs... > =
+            (!std::is_same_v< Sig, Sigs > && ...) && are_distinct_v< Sigs... >;
+
+    } // namespace detail
+
+    // One erased callable reachable through several signatures. The callable is stored once and a single table holds
+    // one call slot per signature, the signature is picked by ordinary overload resolution at the call site.
+    template < class... Sigs >
+    class overloaded_function
+        : public detail::overload_set< overloaded_function< Sigs... >, std::index_sequence_for< Sigs... >, Sigs... > {
+        static_assert(sizeof...(Sigs) != 0, "mr::overloaded_function requires at least one signature");
+        static_assert(detail::are_distinct_v< Sigs... >, "mr::overloaded_function signatures must be distinct");
+
+        template < class, std::size_t, class >
+        friend struct detail::overload_call;
+
+        using Table = detail::overload_table< Sigs... >;
+
+        template < class Callable >
+        static constexpr bool is_valid_v =
+            !std::is_same_v< std::decay_t< Callable >, overloaded_function > &&
+            (detail::overload_slot< Sigs >::template accepts_v< std::decay_t< Callable > > && ...);
+
+      public:
+        constexpr overloaded_function() noexcept = default;
+
+        constexpr overloaded_function(std::nullptr_t) noexcept {
+        }
+
+        template < class Callable, std::enable_if_t< is_valid_v< Callable >, int > = 0 >
+        constexpr overloaded_function(Callable&& Val) {
+            using Callable_t = std::decay_t< Callable >;
+            static_assert(std::is_copy_constructible_v< Callable_t >, "Callable must be copy-constructible");
+
+            if (!detail::constexpr_function_storage::is_null_function(Val)) {
+                detail::constexpr_function_storage::create< Callable_t >(storage, std::forward< Callable >(Val));
+                table = std::addressof(detail::overload_table_for< Callable_t, Sigs... >);
+            }
+        }
+
+        constexpr overloaded_function(const overloaded_function& Val) {
+            if (Val.table) {
+                Val.table->do_op(Val.storage, storage, detail::constexpr_function_op::Copy);
+                table = Val.table;
+            }
+        }
+
+        constexpr overloaded_function(overloaded_function&& Val) noexcept {
+            move_from(Val);
+        }
+
+        constexpr ~overloaded_function() {
+            reset();
+        }
+
+        constexpr overloaded_function& operator=(const overloaded_function& Val) {
+            overloaded_function(Val).swap(*this);
+            return *this;
+        }
+
+        constexpr overloaded_function& operator=(overloaded_function&& Val) noexcept {
+            if (this != std::addressof(Val)) {
+                reset();
+                move_from(Val);
+            }
+            return *this;
+        }
+
+        constexpr overloaded_function& operator=(std::nullptr_t) noexcept {
+            reset();
+            return *this;
+        }
+
+        template < class Callable, std::enable_if_t< is_valid_v< Callable >, int > = 0 >
+        constexpr overloaded_function& operator=(Callable&& Val) {
+            overloaded_function(std::forward< Callable >(Val)).swap(*this);
+            return *this;
+        }
+
+        constexpr void swap(overloaded_function& Val) noexcept {
+            if (this != std::addressof(Val)) {
+                overloaded_function Tmp { std::move(Val) };
+                Val.move_from(*this);
+                move_from(Tmp);
+            }
+        }
+
+        constexpr explicit operator bool() const noexcept {
+            return table != nullptr;
+        }
+
+        template < typename Callable >
+        constexpr Callable* target() noexcept {
+            const overloaded_function* C_function = this;
+            return const_cast< Callable* >(C_function->template target< Callable >());
+        }
+
+        template < typename Callable >
+        constexpr const Callable* target() const noexcept {
+            using Callable_t = std::decay_t< Callable >;
+            if (table && table->get_typeId() == detail::constexpr_function_storage::GetTypeID< Callable_t >()) {
+                return detail::constexpr_function_storage::get_function_pointer< Callable_t >(storage);
+            }
+            return nullptr;
+        }
+
+      private:
+        template < std::size_t I, class... Args >
+        constexpr decltype(auto) call(Args&&... args) const {
+            if (!table) {
+                detail::throw_or_terminate< std::bad_function_call >();
+            }
+            return std::get< I >(table->calls)(storage, std::forward< Args >(args)...);
+        }
+
+        constexpr void reset() noexcept {
+            if (table) {
+                table->do_op(storage, storage, detail::constexpr_function_op::Destroy);
+                table = nullptr;
+            }
+        }
+
+        // Expects *this to be empty, Val is left empty
+        constexpr void move_from(overloaded_function& Val) noexcept {
+            if (Val.table) {
+                Val.table->do_op(Val.storage, storage, detail::constexpr_function_op::Move);
+                table = std::exchange(Val.table, nullptr);
+            }
+        }
+
+        // The operations are reached through the table, only the storage is kept
+        detail::constexpr_function_storage storage {};
+        const Table*                       table { nullptr };
+    };
+
+    template < class... Sigs >
+    constexpr void swap(overloaded_function< Sigs... >& lhs, overloaded_function< Sigs... >& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+} // namespace mr
+
+#endif // !defined(CONSTEXPR_OVERLOADED_FUNCTION_H_INCLUDED_B6C9E4C3_36A4_4994_A6CF_CD7CA40D8E2E)
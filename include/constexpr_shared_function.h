@@ -0,0 +1,16 @@
+#if !defined(CONSTEXPR_SHARED_FUNCTION_H_INCLUDED_7EC77A02_9CB3_4330_B478_DE151A3B0AFA)
+    #define CONSTEXPR_SHARED_FUNCTION_H_INCLUDED_7EC77A02_9CB3_4330_B478_DE151A3B0AFA
+
+// Erased callable with shared ownership: copies share one immutable callable through an intrusive reference count,
+// so copying is O(1). Mutable access through target() first detaches a private copy (copy-on-write).
+
+    #include <constexpr_function.h>
+
+namespace mr {
+
+    template < class F, class RefCount = atomic_refcount >
+    using shared_function = basic_function< F, heap_storage, shared_ownership< RefCount > >;
+
+} // namespace mr
+
+#endif // !defined(CONSTEXPR_SHARED_FUNCTION_H_INCLUDED_7EC77A02_9CB3_4330_B478_DE151A3B0AFA)
@@ -0,0 +1,216 @@
+#if !defined(CONSTEXPR_SIGNAL_H_INCLUDED_24CA6388_CE6D_4E4F_AB58_9CB02522173F)
+    #define CONSTEXPR_SIGNAL_H_INCLUDED_24CA6388_CE6D_4E4F_AB58_9CB02522173F
+
+// Multicast delegate over mr::function. Subscribers live in one contiguous list that is never modified while
+// visible: connect and disconnect publish an edited copy (copy-on-write), emission walks an immutable snapshot
+// without locking and a replaced list is reclaimed once the last emission walking it is done.
+
+    #include <algorithm>
+    #include <atomic_any.h>
+    #include <constexpr_function.h>
+    #include <cstddef>
+    #include <cstdint>
+    #include <utility>
+    #include <vector>
+
+namespace mr {
+
+    namespace detail {
+
+        template < class Slot >
+        struct signal_state {
+            std::vector< Slot > slots {};
+            std::uint64_t       next_id { 1 };
+        };
+
+        // Single-threaded subscriber list, usable in constant evaluation: emission pins the current state through a
+        // plain reference count and edits copy a pinned state instead of modifying it
+        template < class Slot >
+        class signal_local_list {
+            struct node {
+                signal_state< Slot > state;
+                std::size_t          refs { 1 };
+            };
+
+            struct pin {
+                constexpr ~pin() {
+                    release(pinned);
+                }
+
+                node* pinned;
+            };
+
+          public:
+            constexpr signal_local_list() : current(new node {}) {
+            }
+
+            signal_local_list(const signal_local_list&)            = delete;
+            signal_local_list& operator=(const signal_local_list&) = delete;
+
+            constexpr ~signal_local_list() {
+                release(current);
+            }
+
+            template < class Fn >
+            constexpr void visit(Fn&& fn) const {
+                ++current->refs;
+                const pin guard { current };
+                fn(std::as_const(guard.pinned->state.slots));
+            }
+
+            template < class Edit >
+            constexpr auto update(Edit&& edit) {
+                if (current->refs != 1) {
+                    node* copy = new node { current->state };
+                    release(std::exchange(current, copy));
+                }
+                return edit(current->state);
+            }
+
+            [[nodiscard]] constexpr std::size_t size() const noexcept {
+                return current->state.slots.size();
+            }
+
+          private:
+            static constexpr void release(node* ptr) noexcept {
+                if (--ptr->refs == 0) {
+                    delete ptr;
+                }
+            }
+
+            node* current;
+        };
+
+        // Thread-safe subscriber list: emission loads a snapshot without locking, edits retry a compare-exchange
+        // of the whole state and the snapshots keep replaced states alive until they are released
+        template < class Slot >
+        class signal_shared_list {
+          public:
+            template < class Fn >
+            void visit(Fn&& fn) const {
+                const auto pinned = state.load();
+                fn(pinned->slots);
+            }
+
+            template < class Edit >
+            auto update(Edit&& edit) {
+                auto expected = state.load();
+                for (;;) {
+                    signal_state< Slot > next   = *expected;
+                    auto                 result = edit(next);
+                    if (state.compare_exchange(expected, std::move(next))) {
+                        return result;
+                    }
+                }
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept {
+                return state.load()->slots.size();
+            }
+
+          private:
+            atomic_snapshot< signal_state< Slot > > state {};
+        };
+
+    } // namespace detail
+
+    // Threading policies of mr::basic_signal
+    // Plain reference counting, usable in constant evaluation
+    struct single_threaded {
+        template < class Slot >
+        using signal_list = detail::signal_local_list< Slot >;
+    };
+
+    // Emission, connect and disconnect may run concurrently from any thread
+    struct multi_threaded {
+        template < class Slot >
+        using signal_list = detail::signal_shared_list< Slot >;
+    };
+
+    template < class Sig, class Threading = multi_threaded >
+    class basic_signal;
+
+    template < class Ret, class... Args, class Threading >
+    class basic_signal< Ret(Args...), Threading > {
+      public:
+        using slot_type     = function< Ret(Args...) >;
+        using connection_id = std::uint64_t;
+
+        // Never returned by connect()
+        static constexpr connection_id invalid_connection = 0;
+
+        constexpr basic_signal() = default;
+
+        // The callable is erased once, then copied with the list on each edit. Empty callables are not connected.
+        template < class Callable >
+        constexpr connection_id connect(Callable&& Fn) {
+            const slot_type erased { std::forward< Callable >(Fn) };
+            if (!erased) {
+                return invalid_connection;
+            }
+            return list.update([&erased](detail::signal_state< slot >& state) {
+                const connection_id id = state.next_id++;
+                state.slots.push_back(slot { id, erased });
+                return id;
+            });
+        }
+
+        // An emission already in progress may still reach the disconnected subscriber
+        constexpr bool disconnect(connection_id id) {
+            return list.update([id](detail::signal_state< slot >& state) {
+                auto it = std::find_if(state.slots.begin(), state.slots.end(),
+                                       [id](const slot& entry) { return entry.id == id; });
+                if (it == state.slots.end()) {
+                    return false;
+                }
+                state.slots.erase(it);
+                return true;
+            });
+        }
+
+        constexpr void disconnect_all() {
+            list.update([](detail::signal_state< slot >& state) {
+                state.slots.clear();
+                return true;
+            });
+        }
+
+        // Calls every subscriber connected when the emission started, in connection order. Results are discarded.
+        constexpr void emit(Args... args) const {
+            list.visit([&](const std::vector< slot >& slots) {
+                for (const slot& entry : slots) {
+                    entry.fn(args...);
+                }
+            });
+        }
+
+        constexpr void operator()(Args... args) const {
+            emit(std::forward< Args >(args)...);
+        }
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept {
+            return list.size();
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return size() == 0;
+        }
+
+      private:
+        struct slot {
+            connection_id id;
+            slot_type     fn;
+        };
+
+        typename Threading::template signal_list< slot > list {};
+    };
+
+    template < class Sig >
+    using signal = basic_signal< Sig, multi_threaded >;
+
+    template < class Sig >
+    using local_signal = basic_signal< Sig, single_threaded >;
+
+} // namespace mr
+
+#endif // !defined(CONSTEXPR_SIGNAL_H_INCLUDED_24CA6388_CE6D_4E4F_AB58_9CB02522173F)
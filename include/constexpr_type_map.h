@@ -0,0 +1,259 @@
+#if !defined(CONSTEXPR_TYPE_MAP_H_INCLUDED_2ABEF773_5C37_42FE_B03D_6014E3F2A071)
+    #define CONSTEXPR_TYPE_MAP_H_INCLUDED_2ABEF773_5C37_42FE_B03D_6014E3F2A071
+
+    #include <constexpr_any.h>
+    #include <cstddef>
+    #include <cstdint>
+    #include <initializer_list>
+    #include <type_traits>
+    #include <utility>
+
+namespace mr {
+
+    // Heterogeneous map holding at most one value per type, keyed by mr::type_id.
+    // Slots live in one flat array probed linearly, each slot keeps its value in an mr::any.
+    class [[nodiscard]] type_map {
+        struct Slot {
+            type_id key { nullptr };
+            any     value {};
+        };
+
+      public:
+        using size_type = std::size_t;
+
+        constexpr type_map() noexcept = default;
+
+        constexpr type_map(const type_map& rhs) {
+            if (rhs.count != 0) {
+                // Copied aside and published once every value is copied, the copies are freed if one throws
+                struct array_guard {
+                    Slot* array;
+
+                    constexpr ~array_guard() {
+                        delete[] array;
+                    }
+                };
+                array_guard Copy { new Slot[rhs.capacity] };
+                for (size_type i = 0; i < rhs.capacity; ++i) {
+                    if (rhs.slots[i].key) {
+                        Copy.array[i] = rhs.slots[i];
+                    }
+                }
+                slots    = std::exchange(Copy.array, nullptr);
+                capacity = rhs.capacity;
+                count    = rhs.count;
+            }
+        }
+
+        constexpr type_map(type_map&& rhs) noexcept :
+            slots(std::exchange(rhs.slots, nullptr)), capacity(std::exchange(rhs.capacity, 0)),
+            count(std::exchange(rhs.count, 0)) {
+        }
+
+        constexpr ~type_map() noexcept {
+            delete[] slots;
+        }
+
+        constexpr type_map& operator=(const type_map& rhs) {
+            if (std::addressof(rhs) != this) {
+                type_map(rhs).swap(*this);
+            }
+            return *this;
+        }
+
+        constexpr type_map& operator=(type_map&& rhs) noexcept {
+            if (std::addressof(rhs) != this) {
+                type_map(std::move(rhs)).swap(*this);
+            }
+            return *this;
+        }
+
+        constexpr void swap(type_map& rhs) noexcept {
+            std::swap(slots, rhs.slots);
+            std::swap(capacity, rhs.capacity);
+            std::swap(count, rhs.count);
+        }
+
+        // Constructs a T in place, replacing the T already stored if any
+        template < class T, class... Args >
+        constexpr T& emplace(Args&&... args) {
+            return do_emplace< T >(std::forward< Args >(args)...);
+        }
+
+        template < class T, class Elem, class... Args >
+        constexpr T& emplace(std::initializer_list< Elem > il, Args&&... args) {
+            return do_emplace< T >(il, std::forward< Args >(args)...);
+        }
+
+        template < class T >
+        [[nodiscard]] constexpr T* get() noexcept {
+            if (auto index = find(type_id_of< T >()); index != Npos) {
+                return slots[index].value.template cast_to< T >();
+            }
+            return nullptr;
+        }
+
+        template < class T >
+        [[nodiscard]] constexpr const T* get() const noexcept {
+            if (auto index = find(type_id_of< T >()); index != Npos) {
+                return slots[index].value.template cast_to< T >();
+            }
+            return nullptr;
+        }
+
+        template < class T >
+        [[nodiscard]] constexpr bool contains() const noexcept {
+            return find(type_id_of< T >()) != Npos;
+        }
+
+        template < class T >
+        constexpr bool erase() noexcept {
+            auto index = find(type_id_of< T >());
+            if (index == Npos) {
+                return false;
+            }
+
+            // Backward shift deletion keeps every probe sequence gap-free without tombstones
+            const size_type mask = capacity - 1;
+            for (size_type next = (index + 1) & mask; slots[next].key; next = (next + 1) & mask) {
+                const size_type home = home_of(slots[next].key);
+                if (((next - home) & mask) >= ((next - index) & mask)) {
+                    slots[index] = std::move(slots[next]);
+                    index        = next;
+                }
+            }
+            slots[index].key = nullptr;
+            slots[index].value.reset();
+            --count;
+            return true;
+        }
+
+        constexpr void clear() noexcept {
+            for (size_type i = 0; i < capacity; ++i) {
+                slots[i].key = nullptr;
+                slots[i].value.reset();
+            }
+            count = 0;
+        }
+
+        constexpr void reserve(size_type values) {
+            size_type required = Min_capacity;
+            while (required < values * 2) {
+                required *= 2;
+            }
+            if (required > capacity) {
+                rehash(required);
+            }
+        }
+
+        [[nodiscard]] constexpr size_type size() const noexcept {
+            return count;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return count == 0;
+        }
+
+      private:
+        static constexpr size_type Npos         = static_cast< size_type >(-1);
+        static constexpr size_type Min_capacity = 8;
+
+        // Addresses cannot be converted to integers during constant evaluation, every key then starts probing at the
+        // first slot. Maps never outlive the evaluation they were built in, so both schemes never mix.
+        [[nodiscard]] constexpr size_type home_of(type_id key) const noexcept {
+            if (std::is_constant_evaluated()) {
+                return 0;
+            } else {
+                // Fibonacci hashing, the upper bits of the product are the best mixed
+                const auto bits = static_cast< std::uint64_t >(reinterpret_cast< std::uintptr_t >(key));
+                return static_cast< size_type >((bits * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+            }
+        }
+
+        [[nodiscard]] constexpr size_type find(type_id key) const noexcept {
+            if (count == 0) {
+                return Npos;
+            }
+            const size_type mask = capacity - 1;
+            for (size_type index = home_of(key);; index = (index + 1) & mask) {
+                if (slots[index].key == key) {
+                    return index;
+                }
+                if (!slots[index].key) {
+                    return Npos;
+                }
+            }
+        }
+
+        // First free slot for a key known to be absent
+        [[nodiscard]] constexpr size_type probe(type_id key) const noexcept {
+            const size_type mask  = capacity - 1;
+            size_type       index = home_of(key);
+            while (slots[index].key) {
+                index = (index + 1) & mask;
+            }
+            return index;
+        }
+
+        template < class T, class... Args >
+        constexpr T& do_emplace(Args&&... args) {
+            static_assert(std::is_same_v< T, std::decay_t< T > >, "mr::type_map keys must be decayed types");
+
+            const auto key = type_id_of< T >();
+            if (auto index = find(key); index != Npos) {
+                // any::emplace resets the old value first, a throwing constructor must not leave the key without one
+                struct erase_guard {
+                    type_map* map;
+                    bool      armed;
+
+                    constexpr ~erase_guard() {
+                        if (armed) {
+                            map->template erase< T >();
+                        }
+                    }
+                };
+                erase_guard Guard { this, true };
+                T&          res = slots[index].value.template emplace< T >(std::forward< Args >(args)...);
+                Guard.armed     = false;
+                return res;
+            }
+
+            if ((count + 1) * 2 > capacity) {
+                rehash(capacity == 0 ? Min_capacity : capacity * 2);
+            }
+
+            Slot& slot = slots[probe(key)];
+            T&    res  = slot.value.template emplace< T >(std::forward< Args >(args)...);
+            slot.key   = key;
+            ++count;
+            return res;
+        }
+
+        // Only the allocation can throw, the map is unchanged when it does
+        constexpr void rehash(size_type new_capacity) {
+            Slot* const     new_slots    = new Slot[new_capacity];
+            Slot* const     old_slots    = std::exchange(slots, new_slots);
+            const size_type old_capacity = std::exchange(capacity, new_capacity);
+
+            for (size_type i = 0; i < old_capacity; ++i) {
+                if (old_slots[i].key) {
+                    Slot& slot = slots[probe(old_slots[i].key)];
+                    slot.key   = old_slots[i].key;
+                    slot.value = std::move(old_slots[i].value);
+                }
+            }
+            delete[] old_slots;
+        }
+
+        Slot*     slots { nullptr };
+        size_type capacity { 0 };
+        size_type count { 0 };
+    };
+
+    inline constexpr void swap(type_map& lhs, type_map& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+} // namespace mr
+
+#endif // !defined(CONSTEXPR_TYPE_MAP_H_INCLUDED_2ABEF773_5C37_42FE_B03D_6014E3F2A071)
@@ -0,0 +1,508 @@
+#if !defined(COROUTINE_TASK_H_INCLUDED_834814E5_3298_4238_AE9D_8E67A2DA9F69)
+    #define COROUTINE_TASK_H_INCLUDED_834814E5_3298_4238_AE9D_8E67A2DA9F69
+
+// Coroutine support. mr::co_task<T> is a lazily started coroutine that resumes its awaiter by symmetric transfer and
+// can allocate its frame from a caller-provided allocator. mr::any_awaitable<T> erases any awaiter producing T with
+// the storage of mr::function, so holding an awaited co_task costs no allocation besides the coroutine frame.
+// mr::single_thread_executor runs coroutines on the calling thread.
+
+    #include <constexpr_function.h>
+    #include <coroutine>
+    #include <cstddef>
+    #include <deque>
+    #include <exception>
+    #include <memory>
+    #include <new>
+    #include <optional>
+    #include <span>
+    #include <stdexcept>
+    #include <type_traits>
+    #include <utility>
+    #include <vector>
+
+namespace mr {
+
+    template < class T = void >
+    class co_task;
+
+    class single_thread_executor;
+
+    // Bump allocator over a caller-provided buffer for coroutine frames. Blocks are released in LIFO order, which
+    // matches nested coroutines, and the whole buffer is reused once every block was released.
+    class frame_arena {
+        static constexpr std::size_t Align = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+      public:
+        explicit frame_arena(std::span< std::byte > Buffer) noexcept : buffer(Buffer) {
+        }
+
+        frame_arena(const frame_arena&)            = delete;
+        frame_arena& operator=(const frame_arena&) = delete;
+
+        // Throws std::bad_alloc when the buffer is exhausted
+        [[nodiscard]] void* allocate(std::size_t size) {
+            const std::size_t begin = (offset + Align - 1) & ~(Align - 1);
+            if (begin > buffer.size() || size > buffer.size() - begin) {
+                throw std::bad_alloc {};
+            }
+            offset = begin + size;
+            ++live;
+            return buffer.data() + begin;
+        }
+
+        void deallocate(void* ptr, std::size_t size) noexcept {
+            if (--live == 0) {
+                offset = 0;
+            } else if (static_cast< std::byte* >(ptr) + size == buffer.data() + offset) {
+                offset = static_cast< std::size_t >(static_cast< std::byte* >(ptr) - buffer.data());
+            }
+        }
+
+        [[nodiscard]] std::size_t used() const noexcept {
+            return offset;
+        }
+
+        [[nodiscard]] std::size_t live_blocks() const noexcept {
+            return live;
+        }
+
+      private:
+        std::span< std::byte > buffer;
+        std::size_t            offset { 0 };
+        std::size_t            live { 0 };
+    };
+
+    namespace detail {
+
+        template < class Alloc, class = void >
+        inline constexpr bool is_frame_allocator_v = false;
+        template < class Alloc >
+        inline constexpr bool is_frame_allocator_v<
+            Alloc, std::void_t< decltype(static_cast< void* >(std::declval< Alloc& >().allocate(std::size_t {}))),
+                                decltype(std::declval< Alloc& >().deallocate(std::declval< void* >(),
+                                                                             std::size_t {})) > > = true;
+
+        // Stored after the frame: operator delete only receives the pointer and the size, the trailer tells which
+        // allocator the block came from
+        struct co_frame_trailer {
+            void (*deallocate)(void*, void*, std::size_t) noexcept;
+            void* allocator;
+        };
+
+        inline constexpr std::size_t co_frame_trailer_offset(std::size_t size) noexcept {
+            return (size + alignof(co_frame_trailer) - 1) & ~(alignof(co_frame_trailer) - 1);
+        }
+
+        // Coroutines taking (std::allocator_arg, alloc, ...) allocate their frame from alloc, member coroutines
+        // likewise after the object parameter, every other coroutine uses the global operator new
+        struct co_frame_allocation {
+            static void* operator new(std::size_t size) {
+                const std::size_t total = co_frame_trailer_offset(size) + sizeof(co_frame_trailer);
+                return place(::operator new(total), size,
+                             [](void*, void* ptr, std::size_t bytes) noexcept { ::operator delete(ptr, bytes); },
+                             nullptr);
+            }
+
+            template < class Alloc, class... Args, std::enable_if_t< is_frame_allocator_v< Alloc >, int > = 0 >
+            static void* operator new(std::size_t size, std::allocator_arg_t, Alloc& Allocator, Args&...) {
+                const std::size_t total = co_frame_trailer_offset(size) + sizeof(co_frame_trailer);
+                return place(
+                    Allocator.allocate(total), size,
+                    [](void* alloc, void* ptr, std::size_t bytes) noexcept {
+                        static_cast< Alloc* >(alloc)->deallocate(ptr, bytes);
+                    },
+                    std::addressof(Allocator));
+            }
+
+            template < class This, class Alloc, class... Args,
+                       std::enable_if_t< is_frame_allocator_v< Alloc >, int > = 0 >
+            static void* operator new(std::size_t size, This&, std::allocator_arg_t, Alloc& Allocator, Args&...) {
+                return operator new(size, std::allocator_arg, Allocator);
+            }
+
+            static void operator delete(void* ptr, std::size_t size) noexcept {
+                const std::size_t       offset  = co_frame_trailer_offset(size);
+                const co_frame_trailer& trailer = *std::launder(
+                    reinterpret_cast< co_frame_trailer* >(static_cast< std::byte* >(ptr) + offset));
+                trailer.deallocate(trailer.allocator, ptr, offset + sizeof(co_frame_trailer));
+            }
+
+          private:
+            static void* place(void* ptr, std::size_t size, void (*deallocate)(void*, void*, std::size_t) noexcept,
+                               void* allocator) noexcept {
+                ::new (static_cast< std::byte* >(ptr) + co_frame_trailer_offset(size))
+                    co_frame_trailer { deallocate, allocator };
+                return ptr;
+            }
+        };
+
+        struct co_task_promise_base : co_frame_allocation {
+            // Resumes the awaiting coroutine without growing the stack
+            struct final_awaiter {
+                bool await_ready() const noexcept {
+                    return false;
+                }
+
+                template < class Promise >
+                std::coroutine_handle<> await_suspend(std::coroutine_handle< Promise > Self) const noexcept {
+                    return Self.promise().continuation;
+                }
+
+                void await_resume() const noexcept {
+                }
+            };
+
+            std::suspend_always initial_suspend() const noexcept {
+                return {};
+            }
+
+            final_awaiter final_suspend() const noexcept {
+                return {};
+            }
+
+            void unhandled_exception() noexcept {
+                error = std::current_exception();
+            }
+
+            void rethrow_if_failed() const {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+
+            std::coroutine_handle<> continuation { std::noop_coroutine() };
+            std::exception_ptr      error {};
+        };
+
+        template < class T >
+        struct co_task_promise : co_task_promise_base {
+            co_task< T > get_return_object() noexcept {
+                return co_task< T > { std::coroutine_handle< co_task_promise >::from_promise(*this) };
+            }
+
+            template < class U = T, std::enable_if_t< std::is_convertible_v< U&&, T >, int > = 0 >
+            void return_value(U&& Val) {
+                value.emplace(std::forward< U >(Val));
+            }
+
+            T take() {
+                rethrow_if_failed();
+                return std::move(*value);
+            }
+
+            std::optional< T > value {};
+        };
+
+        template <>
+        struct co_task_promise< void > : co_task_promise_base {
+            co_task< void > get_return_object() noexcept;
+
+            void return_void() const noexcept {
+            }
+
+            void take() const {
+                rethrow_if_failed();
+            }
+        };
+
+    } // namespace detail
+
+    // Lazily started coroutine producing T. Awaiting it starts it, and its completion resumes the awaiting coroutine
+    // by symmetric transfer, so arbitrarily long chains of synchronously completing tasks use constant stack (GCC only
+    // emits the required tail call when optimizing).
+    template < class T >
+    class [[nodiscard]] co_task {
+        static_assert(!std::is_reference_v< T >, "mr::co_task does not support reference results");
+
+        friend struct detail::co_task_promise< T >;
+        friend class single_thread_executor;
+
+        using Handle = std::coroutine_handle< detail::co_task_promise< T > >;
+
+        explicit co_task(Handle Coroutine) noexcept : coroutine(Coroutine) {
+        }
+
+      public:
+        using promise_type = detail::co_task_promise< T >;
+        using value_type   = T;
+
+        co_task() noexcept = default;
+
+        co_task(co_task&& Val) noexcept : coroutine(std::exchange(Val.coroutine, nullptr)) {
+        }
+
+        co_task& operator=(co_task&& Val) noexcept {
+            if (this != std::addressof(Val)) {
+                reset();
+                coroutine = std::exchange(Val.coroutine, nullptr);
+            }
+            return *this;
+        }
+
+        ~co_task() {
+            reset();
+        }
+
+        explicit operator bool() const noexcept {
+            return static_cast< bool >(coroutine);
+        }
+
+        [[nodiscard]] bool done() const noexcept {
+            return coroutine && coroutine.done();
+        }
+
+        // Awaiter interface, a task is awaited at most once
+        bool await_ready() const noexcept {
+            return done();
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> Awaiting) noexcept {
+            coroutine.promise().continuation = Awaiting;
+            return coroutine;
+        }
+
+        // Rethrows the exception that left the coroutine
+        T await_resume() {
+            return coroutine.promise().take();
+        }
+
+      private:
+        void reset() noexcept {
+            if (coroutine) {
+                std::exchange(coroutine, nullptr).destroy();
+            }
+        }
+
+        Handle coroutine {};
+    };
+
+    inline co_task< void > detail::co_task_promise< void >::get_return_object() noexcept {
+        return co_task< void > { std::coroutine_handle< co_task_promise >::from_promise(*this) };
+    }
+
+    namespace detail {
+
+        template < class A, class T, class = void >
+        inline constexpr bool is_awaiter_of_v = false;
+        template < class A, class T >
+        inline constexpr bool is_awaiter_of_v<
+            A, T,
+            std::void_t< decltype(static_cast< bool >(std::declval< A& >().await_ready())),
+                         decltype(std::declval< A& >().await_suspend(std::declval< std::coroutine_handle<> >())),
+                         decltype(std::declval< A& >().await_resume()) > > =
+            std::is_void_v< T > || std::is_convertible_v< decltype(std::declval< A& >().await_resume()), T >;
+
+        using awaitable_storage = basic_constexpr_function_storage< sbo_storage<>, move_only_ownership >;
+
+        // One table per awaiter type. suspend normalizes the three await_suspend forms to the handle to resume.
+        template < class T >
+        struct awaitable_table {
+            bool (*do_op)(const awaitable_storage&, awaitable_storage&, constexpr_function_op);
+            bool (*ready)(awaitable_storage&);
+            std::coroutine_handle<> (*suspend)(awaitable_storage&, std::coroutine_handle<>);
+            T (*resume)(awaitable_storage&);
+        };
+
+        template < class Awaiter, class T >
+        struct awaitable_thunks {
+            static Awaiter& get(awaitable_storage& In) noexcept {
+                return *awaitable_storage::get_function_pointer< Awaiter >(In);
+            }
+
+            static bool ready(awaitable_storage& In) {
+                return static_cast< bool >(get(In).await_ready());
+            }
+
+            static std::coroutine_handle<> suspend(awaitable_storage& In, std::coroutine_handle<> Awaiting) {
+                using Result = decltype(get(In).await_suspend(Awaiting));
+                if constexpr (std::is_void_v< Result >) {
+                    get(In).await_suspend(Awaiting);
+                    return std::noop_coroutine();
+                } else if constexpr (std::is_same_v< Result, bool >) {
+                    return get(In).await_suspend(Awaiting) ? std::noop_coroutine() : Awaiting;
+                } else {
+                    return get(In).await_suspend(Awaiting);
+                }
+            }
+
+            static T resume(awaitable_storage& In) {
+                if constexpr (std::is_void_v< T >) {
+                    get(In).await_resume();
+                } else {
+                    return get(In).await_resume();
+                }
+            }
+        };
+
+        template < class Awaiter, class T >
+        inline constexpr awaitable_table< T > awaitable_table_for {
+            &awaitable_storage::Do_op< Awaiter >,
+            &awaitable_thunks< Awaiter, T >::ready,
+            &awaitable_thunks< Awaiter, T >::suspend,
+            &awaitable_thunks< Awaiter, T >::resume,
+        };
+
+    } // namespace detail
+
+    // Move-only erased awaiter producing T. Awaiters up to the inline size of mr::function, such as mr::co_task, are
+    // stored inline. Awaiting an empty any_awaitable is undefined.
+    template < class T = void >
+    class any_awaitable {
+        using Table = detail::awaitable_table< T >;
+
+        template < class Awaiter >
+        static constexpr bool is_valid_v = !std::is_same_v< std::decay_t< Awaiter >, any_awaitable > &&
+                                           detail::is_awaiter_of_v< std::decay_t< Awaiter >, T >;
+
+      public:
+        any_awaitable() noexcept = default;
+
+        template < class Awaiter, std::enable_if_t< is_valid_v< Awaiter >, int > = 0 >
+        any_awaitable(Awaiter&& Val) {
+            using Awaiter_t = std::decay_t< Awaiter >;
+            detail::awaitable_storage::create< Awaiter_t >(storage, std::forward< Awaiter >(Val));
+            table = std::addressof(detail::awaitable_table_for< Awaiter_t, T >);
+        }
+
+        any_awaitable(any_awaitable&& Val) noexcept {
+            move_from(Val);
+        }
+
+        any_awaitable& operator=(any_awaitable&& Val) noexcept {
+            if (this != std::addressof(Val)) {
+                reset();
+                move_from(Val);
+            }
+            return *this;
+        }
+
+        ~any_awaitable() {
+            reset();
+        }
+
+        explicit operator bool() const noexcept {
+            return table != nullptr;
+        }
+
+        bool await_ready() {
+            return table->ready(storage);
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> Awaiting) {
+            return table->suspend(storage, Awaiting);
+        }
+
+        T await_resume() {
+            return table->resume(storage);
+        }
+
+      private:
+        void reset() noexcept {
+            if (table) {
+                table->do_op(storage, storage, detail::constexpr_function_op::Destroy);
+                table = nullptr;
+            }
+        }
+
+        // Expects *this to be empty, Val is left empty
+        void move_from(any_awaitable& Val) noexcept {
+            if (Val.table) {
+                Val.table->do_op(Val.storage, storage, detail::constexpr_function_op::Move);
+                table = std::exchange(Val.table, nullptr);
+            }
+        }
+
+        detail::awaitable_storage storage {};
+        const Table*              table { nullptr };
+    };
+
+    // Runs coroutines on the thread calling run(), in the order they were scheduled
+    class single_thread_executor {
+        struct schedule_awaiter {
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> Awaiting) const {
+                executor->post(Awaiting);
+            }
+
+            void await_resume() const noexcept {
+            }
+
+            single_thread_executor* executor;
+        };
+
+      public:
+        single_thread_executor() = default;
+
+        single_thread_executor(const single_thread_executor&)            = delete;
+        single_thread_executor& operator=(const single_thread_executor&) = delete;
+
+        // co_await executor.schedule() suspends the coroutine and queues it behind every coroutine already queued
+        [[nodiscard]] schedule_awaiter schedule() noexcept {
+            return schedule_awaiter { this };
+        }
+
+        void post(std::coroutine_handle<> Coroutine) {
+            ready.push_back(Coroutine);
+        }
+
+        // The executor owns the task, an exception leaving it is rethrown by run()
+        void spawn(co_task<> Task) {
+            if (Task) {
+                post(Task.coroutine);
+                detached.push_back(std::move(Task));
+            }
+        }
+
+        // Resumes queued coroutines until none is left, returns how many resumptions ran
+        std::size_t run() {
+            std::size_t count = 0;
+            while (!ready.empty()) {
+                const std::coroutine_handle<> next = ready.front();
+                ready.pop_front();
+                next.resume();
+                ++count;
+            }
+            collect();
+            return count;
+        }
+
+        // Runs Task to completion and returns its result. Throws std::logic_error when Task is left suspended with
+        // nothing queued to resume it.
+        template < class T >
+        T run(co_task< T > Task) {
+            post(Task.coroutine);
+            run();
+            if (!Task.done()) {
+                throw std::logic_error { "mr::single_thread_executor: task suspended without being scheduled" };
+            }
+            return Task.await_resume();
+        }
+
+        [[nodiscard]] std::size_t pending() const noexcept {
+            return ready.size();
+        }
+
+      private:
+        // Releases finished detached tasks, rethrowing the first exception found
+        void collect() {
+            for (std::size_t i = 0; i < detached.size();) {
+                if (!detached[i].done()) {
+                    ++i;
+                    continue;
+                }
+                co_task<> finished = std::move(detached[i]);
+                detached.erase(detached.begin() + static_cast< std::ptrdiff_t >(i));
+                finished.await_resume();
+            }
+        }
+
+        std::deque< std::coroutine_handle<> > ready {};
+        std::vector< co_task<> >              detached {};
+    };
+
+} // namespace mr
+
+#endif // !defined(COROUTINE_TASK_H_INCLUDED_834814E5_3298_4238_AE9D_8E67A2DA9F69)
@@ -0,0 +1,352 @@
+#if !defined(ERASURE_COUNTERS_H_INCLUDED_141C0187_FD49_4F69_858A_A03405428D84)
+    #define ERASURE_COUNTERS_H_INCLUDED_141C0187_FD49_4F69_858A_A03405428D84
+
+// Opt-in run-time counters of mr::any and mr::function operations, per erased type and in aggregate. Define
+// MR_ERASURE_COUNTERS to 1 for the whole program to enable them; otherwise every hook is an empty constexpr function
+// and the counter functions below report nothing. Constant evaluation is never counted.
+//
+// Each thread counts into its own table without locking, tables are merged when read. The counters of a thread that
+// has exited are kept, operations after a thread's table is destroyed, such as frees of static objects at exit, are
+// not counted. Enabled counters need RTTI, types are identified by std::type_index.
+
+    #if !defined(MR_ERASURE_COUNTERS)
+        #define MR_ERASURE_COUNTERS 0
+    #endif
+
+    #include <cstdint>
+    #include <cstdio>
+    #include <string>
+    #include <type_traits>
+    #include <typeinfo>
+    #include <vector>
+
+    #if MR_ERASURE_COUNTERS
+        #include <algorithm>
+        #include <atomic>
+        #include <cstdlib>
+        #include <memory>
+        #include <mutex>
+        #include <typeindex>
+        #include <unordered_map>
+        #if __has_include(<cxxabi.h>)
+            #include <cxxabi.h>
+        #endif
+    #endif
+
+namespace mr {
+
+    struct erasure_counters {
+        std::uint64_t allocations { 0 };
+        std::uint64_t frees { 0 };
+        std::uint64_t copies { 0 };
+        std::uint64_t moves { 0 };
+        std::uint64_t cast_hits { 0 };
+        std::uint64_t cast_misses { 0 };
+        std::uint64_t calls { 0 };
+
+        constexpr erasure_counters& operator+=(const erasure_counters& Val) noexcept {
+            allocations += Val.allocations;
+            frees += Val.frees;
+            copies += Val.copies;
+            moves += Val.moves;
+            cast_hits += Val.cast_hits;
+            cast_misses += Val.cast_misses;
+            calls += Val.calls;
+            return *this;
+        }
+    };
+
+    struct erasure_type_counters {
+        std::string      name;
+        erasure_counters counters;
+    };
+
+    namespace detail {
+
+        inline constexpr bool erasure_counters_enabled = MR_ERASURE_COUNTERS != 0;
+
+        enum class erasure_event : int
+        {
+            Allocation,
+            Free,
+            Copy,
+            Move,
+            Cast_hit,
+            Cast_miss,
+            Call,
+            Count,
+        };
+
+    #if MR_ERASURE_COUNTERS
+        inline constexpr std::size_t erasure_event_count = static_cast< std::size_t >(erasure_event::Count);
+
+        // Written by the owning thread only, read by any thread merging the counters
+        struct erasure_type_entry {
+            std::string                  name;
+            std::atomic< bool >*         heap { nullptr };
+            std::atomic< std::uint64_t > values[erasure_event_count] {};
+
+            void add(erasure_event Event) noexcept {
+                auto& Value = values[static_cast< std::size_t >(Event)];
+                Value.store(Value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            erasure_counters load() const noexcept {
+                auto Get = [this](erasure_event Event) {
+                    return values[static_cast< std::size_t >(Event)].load(std::memory_order_relaxed);
+                };
+                return erasure_counters { Get(erasure_event::Allocation), Get(erasure_event::Free),
+                                          Get(erasure_event::Copy),       Get(erasure_event::Move),
+                                          Get(erasure_event::Cast_hit),   Get(erasure_event::Cast_miss),
+                                          Get(erasure_event::Call) };
+            }
+        };
+
+        inline std::string erasure_type_name(const std::type_info& Type) {
+        #if __has_include(<cxxabi.h>)
+            int                                           Status = 0;
+            std::unique_ptr< char, decltype(&std::free) > Name {
+                abi::__cxa_demangle(Type.name(), nullptr, nullptr, &Status), &std::free
+            };
+            if (Status == 0 && Name) {
+                return Name.get();
+            }
+        #endif
+            return Type.name();
+        }
+
+        struct erasure_thread_table;
+
+        // Live thread tables, the merged counters of exited threads, and whether each type is kept on the heap
+        struct erasure_registry {
+            std::mutex                                                   mutex;
+            std::vector< erasure_thread_table* >                         live;
+            std::unordered_map< std::type_index, erasure_type_counters > retired;
+            std::unordered_map< std::type_index, std::atomic< bool > >   heap;
+
+            // Never destroyed, objects freed at exit still count into it
+            static erasure_registry& get() {
+                static erasure_registry& Registry = *new erasure_registry {};
+                return Registry;
+            }
+        };
+
+        // Set once this thread's table is destroyed, hooks running later, from the destructors of static and
+        // thread_local objects, count nothing. Trivially destructible, so it is readable until the thread ends.
+        inline thread_local bool erasure_thread_exited = false;
+
+        struct erasure_thread_table {
+            // Taken by the owning thread to add a type, and by readers, never on the counting path itself
+            std::mutex                                                 mutex;
+            std::unordered_map< std::type_index, erasure_type_entry > types;
+            // Entries cached by erasure_entry_of on this thread, cleared with the table
+            std::vector< erasure_type_entry** > cached;
+
+            erasure_thread_table() {
+                erasure_registry&             Registry = erasure_registry::get();
+                std::lock_guard< std::mutex > Lock { Registry.mutex };
+                Registry.live.push_back(this);
+            }
+
+            ~erasure_thread_table() {
+                erasure_registry&             Registry = erasure_registry::get();
+                std::lock_guard< std::mutex > Lock { Registry.mutex };
+                std::erase(Registry.live, this);
+                for (const auto& [Type, Entry] : types) {
+                    auto& Retired = Registry.retired[Type];
+                    Retired.name  = Entry.name;
+                    Retired.counters += Entry.load();
+                }
+                for (erasure_type_entry** Entry : cached) {
+                    *Entry = nullptr;
+                }
+                erasure_thread_exited = true;
+            }
+
+            erasure_type_entry& find(const std::type_info& Type) {
+                if (auto It = types.find(Type); It != types.end()) {
+                    return It->second;
+                }
+                erasure_registry&    Registry = erasure_registry::get();
+                std::atomic< bool >* Heap     = nullptr;
+                {
+                    // Map nodes are never erased, the flag outlives the entry
+                    std::lock_guard< std::mutex > Lock { Registry.mutex };
+                    Heap = &Registry.heap[Type];
+                }
+                std::lock_guard< std::mutex > Lock { mutex };
+                erasure_type_entry&           Entry = types[Type];
+                Entry.name                          = erasure_type_name(Type);
+                Entry.heap                          = Heap;
+                return Entry;
+            }
+
+            static erasure_thread_table& get() {
+                static thread_local erasure_thread_table Table {};
+                return Table;
+            }
+        };
+
+        // Entry of T in this thread's table, looked up once per thread, null once the table is destroyed
+        template < class T >
+        inline erasure_type_entry* erasure_entry_of() {
+            static thread_local erasure_type_entry* Entry = nullptr;
+            if (!Entry && !erasure_thread_exited) {
+                erasure_thread_table& Table = erasure_thread_table::get();
+                Entry                       = &Table.find(typeid(T));
+                Table.cached.push_back(&Entry);
+            }
+            return Entry;
+        }
+    #endif
+
+        // Counts Event for the erased type T
+        template < class T >
+        constexpr void count_erasure(erasure_event Event) noexcept {
+    #if MR_ERASURE_COUNTERS
+            if (!std::is_constant_evaluated()) {
+                if (erasure_type_entry* Entry = erasure_entry_of< T >()) {
+                    Entry->add(Event);
+                }
+            }
+    #else
+            (void)Event;
+    #endif
+        }
+
+        // Records whether values of T are kept on the heap, so that copies and frees of a value only known through
+        // its std::type_info are counted as allocations and frees
+        template < class T >
+        constexpr void count_erasure_storage(bool Heap) noexcept {
+    #if MR_ERASURE_COUNTERS
+            if (!std::is_constant_evaluated() && Heap) {
+                if (erasure_type_entry* Entry = erasure_entry_of< T >()) {
+                    std::atomic< bool >& Flag = *Entry->heap;
+                    if (!Flag.load(std::memory_order_relaxed)) {
+                        Flag.store(true, std::memory_order_relaxed);
+                    }
+                }
+            }
+    #else
+            (void)Heap;
+    #endif
+        }
+
+        // Counts Event for a value only known through its std::type_info, and Heap_event along with it when values
+        // of that type are kept on the heap. Either can be erasure_event::Count to count nothing.
+        inline void count_erasure(const std::type_info& Type, erasure_event Event,
+                                  erasure_event Heap_event = erasure_event::Count) {
+    #if MR_ERASURE_COUNTERS
+            if (erasure_thread_exited) {
+                return;
+            }
+            erasure_type_entry& Entry = erasure_thread_table::get().find(Type);
+            if (Event != erasure_event::Count) {
+                Entry.add(Event);
+            }
+            if (Heap_event != erasure_event::Count && Entry.heap->load(std::memory_order_relaxed)) {
+                Entry.add(Heap_event);
+            }
+    #else
+            (void)Type, (void)Event, (void)Heap_event;
+    #endif
+        }
+
+    } // namespace detail
+
+    #if MR_ERASURE_COUNTERS
+    namespace detail {
+
+        inline std::unordered_map< std::type_index, erasure_type_counters > erasure_counters_merge() {
+            erasure_registry&                                            Registry = erasure_registry::get();
+            std::lock_guard< std::mutex >                                Lock { Registry.mutex };
+            std::unordered_map< std::type_index, erasure_type_counters > Merged = Registry.retired;
+            for (erasure_thread_table* Table : Registry.live) {
+                std::lock_guard< std::mutex > Table_lock { Table->mutex };
+                for (const auto& [Type, Entry] : Table->types) {
+                    auto& Counters = Merged[Type];
+                    Counters.name  = Entry.name;
+                    Counters.counters += Entry.load();
+                }
+            }
+            return Merged;
+        }
+
+    } // namespace detail
+    #endif
+
+    // Counters of every erased type, merged over all threads, most allocations first then most copies. Empty unless
+    // MR_ERASURE_COUNTERS is enabled.
+    [[nodiscard]] inline std::vector< erasure_type_counters > erasure_counters_snapshot() {
+        std::vector< erasure_type_counters > Result {};
+    #if MR_ERASURE_COUNTERS
+        for (auto& [Type, Counters] : detail::erasure_counters_merge()) {
+            Result.push_back(std::move(Counters));
+        }
+        std::sort(Result.begin(), Result.end(), [](const erasure_type_counters& Lhs, const erasure_type_counters& Rhs) {
+            if (Lhs.counters.allocations != Rhs.counters.allocations) {
+                return Lhs.counters.allocations > Rhs.counters.allocations;
+            }
+            return Lhs.counters.copies > Rhs.counters.copies;
+        });
+    #endif
+        return Result;
+    }
+
+    // Counters of the erased type T, merged over all threads
+    template < class T >
+    [[nodiscard]] erasure_counters erasure_counters_of() {
+    #if MR_ERASURE_COUNTERS
+        const auto Merged = detail::erasure_counters_merge();
+        if (auto It = Merged.find(typeid(T)); It != Merged.end()) {
+            return It->second.counters;
+        }
+    #endif
+        return erasure_counters {};
+    }
+
+    // Sum over every erased type
+    [[nodiscard]] inline erasure_counters erasure_counters_total() {
+        erasure_counters Total {};
+        for (const erasure_type_counters& Type : erasure_counters_snapshot()) {
+            Total += Type.counters;
+        }
+        return Total;
+    }
+
+    // Prints the Max_types types with the most allocations, the ones that would gain the most from inline storage,
+    // followed by the totals
+    inline void dump_erasure_counters(std::FILE* Out = stderr, std::size_t Max_types = 20) {
+        if constexpr (!detail::erasure_counters_enabled) {
+            std::fprintf(Out, "mr erasure counters are disabled, define MR_ERASURE_COUNTERS=1\n");
+            return;
+        }
+        const std::vector< erasure_type_counters > Types = erasure_counters_snapshot();
+
+        erasure_counters Total {};
+        std::fprintf(Out, "%12s %12s %12s %12s %12s %12s %12s  %s\n", "allocations", "frees", "copies", "moves",
+                     "cast hits", "cast misses", "calls", "type");
+        for (std::size_t i = 0; i < Types.size(); ++i) {
+            const erasure_counters& C = Types[i].counters;
+            Total += C;
+            if (i < Max_types) {
+                std::fprintf(Out, "%12llu %12llu %12llu %12llu %12llu %12llu %12llu  %s\n",
+                             static_cast< unsigned long long >(C.allocations),
+                             static_cast< unsigned long long >(C.frees), static_cast< unsigned long long >(C.copies),
+                             static_cast< unsigned long long >(C.moves),
+                             static_cast< unsigned long long >(C.cast_hits),
+                             static_cast< unsigned long long >(C.cast_misses),
+                             static_cast< unsigned long long >(C.calls), Types[i].name.c_str());
+            }
+        }
+        std::fprintf(Out, "%12llu %12llu %12llu %12llu %12llu %12llu %12llu  total of %zu types\n",
+                     static_cast< unsigned long long >(Total.allocations),
+                     static_cast< unsigned long long >(Total.frees), static_cast< unsigned long long >(Total.copies),
+                     static_cast< unsigned long long >(Total.moves), static_cast< unsigned long long >(Total.cast_hits),
+                     static_cast< unsigned long long >(Total.cast_misses),
+                     static_cast< unsigned long long >(Total.calls), Types.size());
+    }
+
+} // namespace mr
+
+#endif // !defined(ERASURE_COUNTERS_H_INCLUDED_141C0187_FD49_4F69_858A_A03405428D84)
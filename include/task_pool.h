@@ -0,0 +1,321 @@
+#if !defined(TASK_POOL_H_INCLUDED_475C7F9A_E173_4BC4_A347_3A020027C4DE)
+    #define TASK_POOL_H_INCLUDED_475C7F9A_E173_4BC4_A347_3A020027C4DE
+
+// Work-stealing thread pool over move-only erased tasks stored inline, so submitting a task never allocates.
+//
+// Every worker owns a fixed-size Chase-Lev deque: the owner pushes and pops at the bottom, other workers steal from
+// the top. A task is moved out of its slot only after the slot was claimed, and each slot carries an occupied flag
+// the owner checks before reusing it, so tasks need not be trivially copyable. Tasks submitted from outside the pool,
+// or overflowing a full deque, go to a shared injection queue that workers drain in batches.
+
+    #include <algorithm>
+    #include <atomic>
+    #include <condition_variable>
+    #include <constexpr_function.h>
+    #include <cstddef>
+    #include <cstdint>
+    #include <deque>
+    #include <iterator>
+    #include <memory>
+    #include <mutex>
+    #include <optional>
+    #include <thread>
+    #include <utility>
+    #include <vector>
+
+namespace mr {
+
+    inline constexpr std::size_t task_inline_size = 6 * sizeof(void*);
+
+    // Erased task: move-only, stored inline, callables larger than task_inline_size do not compile
+    using task = basic_function< void(), inline_storage< task_inline_size, alignof(void*) >, move_only_ownership >;
+
+    namespace detail {
+
+        inline constexpr std::size_t task_pool_cache_line = 64;
+
+        // Single owner, multiple thieves
+        class task_deque {
+            struct slot {
+                std::atomic< bool > occupied { false };
+                task                value {};
+            };
+
+          public:
+            static constexpr std::int64_t capacity = 1024;
+
+            task_deque() : slots(std::make_unique< slot[] >(capacity)) {
+            }
+
+            // Owner only. Returns false when full, the task is left untouched then.
+            bool push(task& value) noexcept {
+                const std::int64_t b = bottom.load(std::memory_order_relaxed);
+                const std::int64_t t = top.load(std::memory_order_acquire);
+                slot&              s = slots[static_cast< std::size_t >(b & (capacity - 1))];
+                // The slot may still be read by a thief that claimed it before the deque wrapped around
+                if (b - t >= capacity || s.occupied.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                s.value = std::move(value);
+                s.occupied.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return true;
+            }
+
+            // Owner only, newest first
+            std::optional< task > pop() noexcept {
+                const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+                bottom.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                std::int64_t t = top.load(std::memory_order_relaxed);
+
+                if (t > b) {
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                    return std::nullopt;
+                }
+                if (t == b) {
+                    // Last task, race the thieves for it
+                    const bool won =
+                        top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                    if (!won) {
+                        return std::nullopt;
+                    }
+                }
+                return release(b);
+            }
+
+            // Any thread, oldest first
+            std::optional< task > steal() noexcept {
+                std::int64_t t = top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const std::int64_t b = bottom.load(std::memory_order_acquire);
+
+                if (t >= b ||
+                    !top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    return std::nullopt;
+                }
+                return release(t);
+            }
+
+          private:
+            std::optional< task > release(std::int64_t index) noexcept {
+                slot&                 s = slots[static_cast< std::size_t >(index & (capacity - 1))];
+                std::optional< task > value { std::move(s.value) };
+                s.occupied.store(false, std::memory_order_release);
+                return value;
+            }
+
+            alignas(task_pool_cache_line) std::atomic< std::int64_t > top { 0 };
+            alignas(task_pool_cache_line) std::atomic< std::int64_t > bottom { 0 };
+            std::unique_ptr< slot[] > slots;
+        };
+
+    } // namespace detail
+
+    class task_pool {
+        struct alignas(detail::task_pool_cache_line) worker {
+            detail::task_deque deque {};
+            std::thread        thread {};
+        };
+
+        struct current_worker {
+            task_pool*  pool { nullptr };
+            std::size_t index { 0 };
+        };
+
+        // Tasks moved from the injection queue to the worker's deque in one go
+        static constexpr std::size_t Injection_batch = 32;
+
+      public:
+        explicit task_pool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency())) :
+            workers(std::max< std::size_t >(threads, 1)) {
+            try {
+                for (std::size_t i = 0; i < workers.size(); ++i) {
+                    workers[i].thread = std::thread { [this, i] { run_worker(i); } };
+                }
+            } catch (...) {
+                // ~task_pool does not run, the workers already started must be joined before they are destroyed
+                stop();
+                throw;
+            }
+        }
+
+        task_pool(const task_pool&)            = delete;
+        task_pool& operator=(const task_pool&) = delete;
+
+        // Runs every task still queued, then joins the workers
+        ~task_pool() {
+            stop();
+        }
+
+        // From a worker the task goes to its own deque, from any other thread to the injection queue
+        template < class Callable >
+        void submit(Callable&& Fn) {
+            task value { std::forward< Callable >(Fn) };
+            if (!value) {
+                return;
+            }
+            unfinished.fetch_add(1, std::memory_order_relaxed);
+
+            const current_worker& self = current();
+            if (self.pool != this || !workers[self.index].deque.push(value)) {
+                std::lock_guard< std::mutex > lock { injection_mutex };
+                injection.push_back(std::move(value));
+            }
+            signal(1);
+        }
+
+        // Submits every callable of [first, last) with one lock of the injection queue
+        template < class It >
+        void submit_batch(It first, It last) {
+            std::size_t count = 0;
+            {
+                std::lock_guard< std::mutex > lock { injection_mutex };
+                for (; first != last; ++first) {
+                    task value { std::move(*first) };
+                    if (value) {
+                        injection.push_back(std::move(value));
+                        ++count;
+                    }
+                }
+            }
+            if (count != 0) {
+                unfinished.fetch_add(count, std::memory_order_relaxed);
+                signal(count);
+            }
+        }
+
+        template < class Range >
+        void submit_batch(Range&& Fns) {
+            submit_batch(std::begin(Fns), std::end(Fns));
+        }
+
+        // Blocks until every submitted task, including tasks submitted meanwhile, has run. Not callable from a task.
+        void wait_idle() const noexcept {
+            for (auto count = unfinished.load(std::memory_order_acquire); count != 0;
+                 count      = unfinished.load(std::memory_order_acquire)) {
+                unfinished.wait(count, std::memory_order_acquire);
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept {
+            return workers.size();
+        }
+
+      private:
+        // Runs every task still queued, then joins the workers that were started
+        void stop() {
+            {
+                std::lock_guard< std::mutex > lock { sleep_mutex };
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto& w : workers) {
+                if (w.thread.joinable()) {
+                    w.thread.join();
+                }
+            }
+        }
+
+        static current_worker& current() noexcept {
+            static thread_local current_worker self {};
+            return self;
+        }
+
+        void signal(std::size_t count) {
+            queued.fetch_add(count, std::memory_order_seq_cst);
+            if (sleepers.load(std::memory_order_seq_cst) != 0) {
+                std::lock_guard< std::mutex > lock { sleep_mutex };
+                if (count == 1) {
+                    wake.notify_one();
+                } else {
+                    wake.notify_all();
+                }
+            }
+        }
+
+        std::optional< task > find_task(std::size_t index, std::uint64_t& seed) {
+            if (auto value = workers[index].deque.pop()) {
+                return value;
+            }
+            if (auto value = take_injected(index)) {
+                return value;
+            }
+            // Start at a random victim so thieves spread over the workers
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            const std::size_t first = static_cast< std::size_t >(seed % workers.size());
+            for (std::size_t i = 0; i < workers.size(); ++i) {
+                const std::size_t victim = (first + i) % workers.size();
+                if (victim == index) {
+                    continue;
+                }
+                if (auto value = workers[victim].deque.steal()) {
+                    return value;
+                }
+            }
+            return std::nullopt;
+        }
+
+        std::optional< task > take_injected(std::size_t index) {
+            std::lock_guard< std::mutex > lock { injection_mutex };
+            if (injection.empty()) {
+                return std::nullopt;
+            }
+            std::optional< task > value { std::move(injection.front()) };
+            injection.pop_front();
+            // Move part of the backlog to the own deque where idle workers can steal it without the lock
+            for (std::size_t i = 1; i < Injection_batch && !injection.empty(); ++i) {
+                if (!workers[index].deque.push(injection.front())) {
+                    break;
+                }
+                injection.pop_front();
+            }
+            return value;
+        }
+
+        void run_worker(std::size_t index) {
+            current() = current_worker { this, index };
+
+            std::uint64_t seed = 0x9E3779B97F4A7C15ull * (index + 1);
+            for (;;) {
+                if (auto value = find_task(index, seed)) {
+                    queued.fetch_sub(1, std::memory_order_relaxed);
+                    (*value)();
+                    if (unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        unfinished.notify_all();
+                    }
+                    continue;
+                }
+
+                std::unique_lock< std::mutex > lock { sleep_mutex };
+                sleepers.fetch_add(1, std::memory_order_seq_cst);
+                wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_seq_cst) != 0; });
+                sleepers.fetch_sub(1, std::memory_order_relaxed);
+                if (stopping && queued.load(std::memory_order_seq_cst) == 0) {
+                    return;
+                }
+            }
+        }
+
+        std::vector< worker > workers;
+
+        std::mutex         injection_mutex {};
+        std::deque< task > injection {};
+
+        // Tasks waiting in a deque or the injection queue, and tasks submitted but not finished yet
+        alignas(detail::task_pool_cache_line) std::atomic< std::size_t > queued { 0 };
+        alignas(detail::task_pool_cache_line) std::atomic< std::size_t > unfinished { 0 };
+
+        std::mutex              sleep_mutex {};
+        std::condition_variable wake {};
+        std::atomic< std::size_t > sleepers { 0 };
+        bool                    stopping { false };
+    };
+
+} // namespace mr
+
+#endif // !defined(TASK_POOL_H_INCLUDED_475C7F9A_E173_4BC4_A347_3A020027C4DE)
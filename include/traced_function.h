@@ -0,0 +1,406 @@
+#if !defined(TRACED_FUNCTION_H_INCLUDED_E4151C91_0B80_4139_8BEC_A948E5B80BFD)
+    #define TRACED_FUNCTION_H_INCLUDED_E4151C91_0B80_4139_8BEC_A948E5B80BFD
+
+// mr::function whose calls are bracketed by the begin/end hooks of a tracing policy, each call carrying the type_id and
+// readable name of the erased callable. The callable is stored wrapped in a stateless tracing thunk of the same size,
+// so inline storage decisions are unchanged. Constant evaluation is never traced.
+//
+// A tracing policy provides, for any callable type C:
+//   using token = ...;
+//   template < class C > static token begin(const mr::trace_site& Site) noexcept;
+//   template < class C > static void  end(const mr::trace_site& Site, token Token) noexcept;
+// end is called even when the call throws. mr::sampled_latency times one call in N and keeps an HDR-style latency
+// histogram per callable type.
+
+    #include <algorithm>
+    #include <atomic>
+    #include <bit>
+    #include <chrono>
+    #include <constexpr_any.h>
+    #include <constexpr_function.h>
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstdio>
+    #include <functional>
+    #include <string_view>
+    #include <type_traits>
+    #include <utility>
+
+    #if defined(__x86_64__) || defined(__i386__)
+        #include <x86intrin.h>
+    #elif defined(_M_X64) || defined(_M_IX86)
+        #include <intrin.h>
+    #endif
+
+namespace mr {
+
+    namespace detail {
+
+        template < class T >
+        constexpr std::string_view raw_type_name() noexcept {
+    #if defined(_MSC_VER) && !defined(__clang__)
+            return __FUNCSIG__;
+    #else
+            return __PRETTY_FUNCTION__;
+    #endif
+        }
+
+        // The decoration around the type is measured on a known type
+        inline constexpr std::string_view raw_int_name     = raw_type_name< int >();
+        inline constexpr std::size_t      type_name_prefix = raw_int_name.find("int");
+        inline constexpr std::size_t      type_name_suffix = raw_int_name.size() - type_name_prefix - 3;
+
+        // Readable name of T as the compiler spells it, without RTTI
+        template < class T >
+        constexpr std::string_view type_name() noexcept {
+            constexpr std::string_view Raw = raw_type_name< T >();
+            return Raw.substr(type_name_prefix, Raw.size() - type_name_prefix - type_name_suffix);
+        }
+
+    } // namespace detail
+
+    // Identity of a traced callable type, one object per type
+    struct trace_site {
+        type_id          type;
+        std::string_view name;
+    };
+
+    template < class C >
+    inline constexpr trace_site trace_site_of { type_id_of< C >(), detail::type_name< C >() };
+
+    namespace detail {
+
+        template < class Callable, class Tracer >
+        class traced_callable {
+            // Calls end once the call returns or throws
+            struct guard {
+                typename Tracer::token token;
+
+                constexpr ~guard() {
+                    if (!std::is_constant_evaluated()) {
+                        Tracer::template end< Callable >(trace_site_of< Callable >, token);
+                    }
+                }
+            };
+
+          public:
+            template < class... Args >
+            constexpr explicit traced_callable(std::in_place_t, Args&&... args) :
+                callable(std::forward< Args >(args)...) {
+            }
+
+            template < class... Args >
+            constexpr decltype(auto) operator()(Args&&... args) {
+                return call(callable, std::forward< Args >(args)...);
+            }
+
+            template < class... Args >
+            constexpr decltype(auto) operator()(Args&&... args) const {
+                return call(callable, std::forward< Args >(args)...);
+            }
+
+            Callable callable;
+
+          private:
+            template < class F, class... Args >
+            static constexpr decltype(auto) call(F& Fn, Args&&... args) {
+                if (std::is_constant_evaluated()) {
+                    return std::invoke(Fn, std::forward< Args >(args)...);
+                }
+                guard Guard { Tracer::template begin< Callable >(trace_site_of< Callable >) };
+                return std::invoke(Fn, std::forward< Args >(args)...);
+            }
+        };
+
+    } // namespace detail
+
+    // mr::basic_function tracing every call through Tracer
+    template < class F, class Tracer, class Storage = sbo_storage<>, class Ownership = unique_ownership >
+    class traced_function : public basic_function< F, Storage, Ownership > {
+        using Base     = basic_function< F, Storage, Ownership >;
+        using Raw_base = detail::basic_constexpr_function_base< Storage, Ownership >;
+
+        template < class Callable >
+        using traced_t = detail::traced_callable< std::decay_t< Callable >, Tracer >;
+
+        template < class Callable >
+        static constexpr bool is_callable_v =
+            !std::is_same_v< std::decay_t< Callable >, traced_function > &&
+            !std::is_same_v< std::decay_t< Callable >, std::nullptr_t > &&
+            std::is_constructible_v< Base, traced_t< Callable > >;
+
+      public:
+        using tracer_type = Tracer;
+
+        constexpr traced_function() noexcept = default;
+
+        constexpr traced_function(std::nullptr_t) noexcept {
+        }
+
+        // A null function pointer, member pointer or empty function gives an empty traced_function
+        template < class Callable, std::enable_if_t< is_callable_v< Callable >, int > = 0 >
+        constexpr traced_function(Callable&& Val) : Base(make(std::forward< Callable >(Val))) {
+        }
+
+        // The callable is built from args inside its tracing wrapper, in its final storage
+        template < class Callable, class... CtorArgs,
+                   std::enable_if_t< std::is_constructible_v< Base, std::in_place_type_t< traced_t< Callable > >,
+                                                              std::in_place_t, CtorArgs... >,
+                                     int > = 0 >
+        constexpr explicit traced_function(std::in_place_type_t< Callable >, CtorArgs&&... args) :
+            Base(std::in_place_type< traced_t< Callable > >, std::in_place, std::forward< CtorArgs >(args)...) {
+        }
+
+        template < class Callable, class... CtorArgs,
+                   std::enable_if_t< std::is_constructible_v< Base, std::in_place_type_t< traced_t< Callable > >,
+                                                              std::in_place_t, CtorArgs... >,
+                                     int > = 0 >
+        constexpr std::decay_t< Callable >& emplace(CtorArgs&&... args) {
+            return Base::template emplace< traced_t< Callable > >(std::in_place, std::forward< CtorArgs >(args)...)
+                .callable;
+        }
+
+        template < class Callable, std::enable_if_t< is_callable_v< Callable >, int > = 0 >
+        constexpr traced_function& operator=(Callable&& Val) {
+            traced_function(std::forward< Callable >(Val)).swap(*this);
+            return *this;
+        }
+
+        constexpr traced_function& operator=(std::nullptr_t) noexcept {
+            Base::operator=(nullptr);
+            return *this;
+        }
+
+        // The target is the callable as given, not its tracing wrapper
+        template < class Callable >
+        constexpr Callable* target() noexcept(!Ownership::is_shared) {
+            auto* Traced = Base::template target< traced_t< Callable > >();
+            return Traced ? std::addressof(Traced->callable) : nullptr;
+        }
+
+        template < class Callable >
+        constexpr const Callable* target() const noexcept {
+            const auto* Traced = Base::template target< traced_t< Callable > >();
+            return Traced ? std::addressof(Traced->callable) : nullptr;
+        }
+
+      private:
+        template < class Callable >
+        static constexpr Base make(Callable&& Val) {
+            // Not a conditional expression, GCC 12 destroys its result early during constant evaluation
+            if (Raw_base::is_null_function(Val)) {
+                return Base {};
+            }
+            return Base { traced_t< Callable > { std::in_place, std::forward< Callable >(Val) } };
+        }
+    };
+
+    // Clock sources of mr::sampled_latency
+    struct steady_clock_source {
+        static constexpr std::string_view unit = "ns";
+
+        static std::uint64_t now() noexcept {
+            return static_cast< std::uint64_t >(std::chrono::duration_cast< std::chrono::nanoseconds >(
+                                                    std::chrono::steady_clock::now().time_since_epoch())
+                                                    .count());
+        }
+    };
+
+    // Time stamp counter of x86, in reference cycles, steady_clock elsewhere. Not serializing, so it can be off by
+    // the few instructions executed out of order around the call.
+    struct tsc_clock_source {
+    #if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        static constexpr std::string_view unit = "cycles";
+
+        static std::uint64_t now() noexcept {
+            return __rdtsc();
+        }
+    #else
+        static constexpr std::string_view unit = steady_clock_source::unit;
+
+        static std::uint64_t now() noexcept {
+            return steady_clock_source::now();
+        }
+    #endif
+    };
+
+    // Log-linear histogram of positive integers in the manner of HdrHistogram: every power of two is split into
+    // 2^Sub_bucket_bits buckets, so a recorded value is known within 1/2^Sub_bucket_bits of itself. Recording is a
+    // relaxed atomic increment, histograms can be read while recorded into.
+    class latency_histogram {
+      public:
+        static constexpr unsigned    Sub_bucket_bits  = 4;
+        static constexpr std::size_t Sub_bucket_count = std::size_t { 1 } << Sub_bucket_bits;
+        static constexpr std::size_t Bucket_count     = (64 - Sub_bucket_bits + 1) * Sub_bucket_count;
+
+        static constexpr std::size_t bucket_index(std::uint64_t Value) noexcept {
+            if (Value < Sub_bucket_count) {
+                return static_cast< std::size_t >(Value);
+            }
+            const unsigned Shift = static_cast< unsigned >(std::bit_width(Value)) - Sub_bucket_bits - 1;
+            return (Shift + 1) * Sub_bucket_count + static_cast< std::size_t >((Value >> Shift) - Sub_bucket_count);
+        }
+
+        // Smallest and largest values counted in a bucket
+        static constexpr std::uint64_t bucket_lowest(std::size_t Index) noexcept {
+            if (Index < Sub_bucket_count) {
+                return Index;
+            }
+            const std::size_t Shift = Index / Sub_bucket_count - 1;
+            return static_cast< std::uint64_t >(Index % Sub_bucket_count + Sub_bucket_count) << Shift;
+        }
+
+        static constexpr std::uint64_t bucket_highest(std::size_t Index) noexcept {
+            if (Index < Sub_bucket_count) {
+                return Index;
+            }
+            const std::size_t Shift = Index / Sub_bucket_count - 1;
+            return bucket_lowest(Index) + ((std::uint64_t { 1 } << Shift) - 1);
+        }
+
+        void record(std::uint64_t Value) noexcept {
+            buckets[bucket_index(Value)].fetch_add(1, std::memory_order_relaxed);
+            total.fetch_add(1, std::memory_order_relaxed);
+            sum.fetch_add(Value, std::memory_order_relaxed);
+            std::uint64_t Max = max_value.load(std::memory_order_relaxed);
+            while (Value > Max && !max_value.compare_exchange_weak(Max, Value, std::memory_order_relaxed)) {
+            }
+        }
+
+        [[nodiscard]] std::uint64_t count() const noexcept {
+            return total.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::uint64_t max() const noexcept {
+            return max_value.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] double mean() const noexcept {
+            const std::uint64_t Count = count();
+            return Count == 0 ? 0. : static_cast< double >(sum.load(std::memory_order_relaxed)) / Count;
+        }
+
+        // Highest value equivalent to the one below which Percentile % of the recorded values fall
+        [[nodiscard]] std::uint64_t value_at_percentile(double Percentile) const noexcept {
+            const std::uint64_t Count = count();
+            if (Count == 0) {
+                return 0;
+            }
+            const double        Clamped = std::clamp(Percentile, 0., 100.);
+            const std::uint64_t Rank    = std::max< std::uint64_t >(
+                1, static_cast< std::uint64_t >(Clamped / 100. * static_cast< double >(Count) + 0.5));
+            std::uint64_t Seen = 0;
+            for (std::size_t i = 0; i < Bucket_count; ++i) {
+                Seen += buckets[i].load(std::memory_order_relaxed);
+                if (Seen >= Rank) {
+                    return std::min(bucket_highest(i), max());
+                }
+            }
+            return max();
+        }
+
+        // Calls Fn(lowest, highest, count) for every non-empty bucket, in increasing order
+        template < class Fn >
+        void for_each_bucket(Fn&& Fn_) const {
+            for (std::size_t i = 0; i < Bucket_count; ++i) {
+                if (const std::uint64_t Count = buckets[i].load(std::memory_order_relaxed); Count != 0) {
+                    std::invoke(Fn_, bucket_lowest(i), bucket_highest(i), Count);
+                }
+            }
+        }
+
+      private:
+        std::atomic< std::uint64_t > buckets[Bucket_count] {};
+        std::atomic< std::uint64_t > total { 0 };
+        std::atomic< std::uint64_t > sum { 0 };
+        std::atomic< std::uint64_t > max_value { 0 };
+    };
+
+    // Tracing policy timing one call in Sample_every per thread with Clock, into one latency_histogram per callable
+    // type. Unsampled calls cost a thread-local decrement and a branch on each side.
+    template < std::uint32_t Sample_every = 64, class Clock = tsc_clock_source >
+    class sampled_latency {
+        static_assert(Sample_every != 0, "mr::sampled_latency samples at least one call in Sample_every");
+
+        struct entry {
+            explicit entry(const trace_site& Site) : site(&Site), next(head.load(std::memory_order_relaxed)) {
+                while (!head.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {
+                }
+            }
+
+            const trace_site* site;
+            entry*            next;
+            latency_histogram histogram {};
+        };
+
+        inline static std::atomic< entry* > head { nullptr };
+
+        template < class C >
+        static entry& entry_of() {
+            static entry Entry { trace_site_of< C > };
+            return Entry;
+        }
+
+        static std::uint32_t& countdown() noexcept {
+            static thread_local std::uint32_t Countdown = 1;
+            return Countdown;
+        }
+
+      public:
+        using clock = Clock;
+
+        // Start of a sampled call, 0 for the others
+        using token = std::uint64_t;
+
+        template < class C >
+        static token begin(const trace_site&) noexcept {
+            if (--countdown() != 0) {
+                return 0;
+            }
+            countdown() = Sample_every;
+            // A start of 0 would read as unsampled, the clock is never that close to its epoch in practice
+            return Clock::now() | 1;
+        }
+
+        template < class C >
+        static void end(const trace_site&, token Start) noexcept {
+            if (Start != 0) {
+                const std::uint64_t Now = Clock::now();
+                entry_of< C >().histogram.record(Now > Start ? Now - Start : 0);
+            }
+        }
+
+        // Histogram of C, empty until one of its calls was sampled
+        template < class C >
+        static const latency_histogram& histogram() {
+            return entry_of< C >().histogram;
+        }
+
+        // Calls Fn(const trace_site&, const latency_histogram&) for every callable type sampled so far
+        template < class Fn >
+        static void for_each(Fn&& Fn_) {
+            for (const entry* It = head.load(std::memory_order_acquire); It; It = It->next) {
+                std::invoke(Fn_, *It->site, It->histogram);
+            }
+        }
+
+        // One line per callable type: sampled calls, mean, percentiles and maximum in Clock's unit
+        static void dump(std::FILE* Out = stderr) {
+            std::fprintf(Out, "%10s %10s %10s %10s %10s %10s %10s  %s (%.*s)\n", "samples", "mean", "p50", "p90",
+                         "p99", "p99.9", "max", "callable", static_cast< int >(Clock::unit.size()), Clock::unit.data());
+            for_each([Out](const trace_site& Site, const latency_histogram& Histogram) {
+                std::fprintf(Out, "%10llu %10.1f %10llu %10llu %10llu %10llu %10llu  %.*s\n",
+                             static_cast< unsigned long long >(Histogram.count()), Histogram.mean(),
+                             static_cast< unsigned long long >(Histogram.value_at_percentile(50.)),
+                             static_cast< unsigned long long >(Histogram.value_at_percentile(90.)),
+                             static_cast< unsigned long long >(Histogram.value_at_percentile(99.)),
+                             static_cast< unsigned long long >(Histogram.value_at_percentile(99.9)),
+                             static_cast< unsigned long long >(Histogram.max()), static_cast< int >(Site.name.size()),
+                             Site.name.data());
+            });
+        }
+    };
+
+} // namespace mr
+
+#endif // !defined(TRACED_FUNCTION_H_INCLUDED_E4151C91_0B80_4139_8BEC_A948E5B80BFD)
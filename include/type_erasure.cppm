@@ -0,0 +1,43 @@
+// Named module mr.type_erasure over constexpr_any.h and constexpr_function.h. Importers reuse the compiled module
+// interface instead of parsing the headers and the standard headers they include in every translation unit.
+// Macros such as MR_EXCEPTIONS and MR_ERASURE_COUNTERS take effect when the module itself is built, not in its
+// importers, which also need the standard headers they use themselves, such as <utility> for std::in_place_type.
+
+module;
+
+// Every standard header the exported headers include, so that none of them is attached to the module
+#include <any>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#if defined(MR_ERASURE_COUNTERS) && MR_ERASURE_COUNTERS
+    #include <algorithm>
+    #include <cstdlib>
+    #include <mutex>
+    #include <typeindex>
+    #include <unordered_map>
+    #if __has_include(<cxxabi.h>)
+        #include <cxxabi.h>
+    #endif
+#endif
+
+export module mr.type_erasure;
+
+export {
+#include <constexpr_any.h>
+#include <constexpr_function.h>
+}
@@ -0,0 +1,31 @@
+################################################################################
+### mr.type_erasure named module, built from type_erasure.cppm
+################################################################################
+# mr_add_type_erasure_module(<target>) adds a static library that compiles the module interface, targets linking
+# it can `import mr.type_erasure;`. Only GCC 11 or newer is supported, through -fmodules-ts and a module mapper file,
+# so that no CMake with C++20 module scanning is needed. MR_TYPE_ERASURE_MODULE is OFF for other compilers.
+
+include_guard(GLOBAL)
+
+set(MR_TYPE_ERASURE_MODULE_DIR "${CMAKE_CURRENT_LIST_DIR}")
+
+if(CMAKE_CXX_COMPILER_ID MATCHES "GNU" AND CMAKE_CXX_COMPILER_VERSION VERSION_GREATER_EQUAL 11)
+    set(MR_TYPE_ERASURE_MODULE_DEFAULT ON)
+else()
+    set(MR_TYPE_ERASURE_MODULE_DEFAULT OFF)
+endif()
+option(MR_TYPE_ERASURE_MODULE "Build the mr.type_erasure named module" ${MR_TYPE_ERASURE_MODULE_DEFAULT})
+
+function(mr_add_type_erasure_module TARGET)
+    set(MAPPER "${CMAKE_CURRENT_BINARY_DIR}/${TARGET}.mapper")
+    set(GCM "${CMAKE_CURRENT_BINARY_DIR}/${TARGET}.gcm")
+    file(WRITE "${MAPPER}" "mr.type_erasure ${GCM}\n")
+
+    set(SOURCE "${MR_TYPE_ERASURE_MODULE_DIR}/type_erasure.cppm")
+    set_source_files_properties("${SOURCE}" PROPERTIES LANGUAGE CXX COMPILE_OPTIONS "-xc++" OBJECT_OUTPUTS "${GCM}")
+
+    add_library(${TARGET} STATIC "${SOURCE}")
+    set_target_properties(${TARGET} PROPERTIES LINKER_LANGUAGE CXX)
+    target_include_directories(${TARGET} PUBLIC "${MR_TYPE_ERASURE_MODULE_DIR}")
+    target_compile_options(${TARGET} PUBLIC -fmodules-ts "-fmodule-mapper=${MAPPER}")
+endfunction()
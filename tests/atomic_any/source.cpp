@@ -0,0 +1,173 @@
+#include <array>
+#include <atomic>
+#include <atomic_any.h>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#define TEST_ASSERT(x) \
+    if (!(x)) {        \
+        return false;  \
+    }
+
+namespace test_helpers {
+
+    inline std::atomic< int > Live_payloads { 0 };
+
+    // Large enough to live on the heap inside std::any, every word is derived from the sequence number so a torn or
+    // reclaimed read shows up as a checksum mismatch
+    struct Payload {
+        explicit Payload(std::uint64_t seq = 0) {
+            for (std::size_t i = 0; i < words.size(); ++i) {
+                words[i] = seq * (i + 1);
+            }
+            ++Live_payloads;
+        }
+
+        Payload(const Payload& rhs) : words(rhs.words) {
+            ++Live_payloads;
+        }
+
+        ~Payload() {
+            words.fill(~std::uint64_t { 0 });
+            --Live_payloads;
+        }
+
+        std::uint64_t sequence() const noexcept {
+            return words[0];
+        }
+
+        bool is_consistent() const noexcept {
+            for (std::size_t i = 0; i < words.size(); ++i) {
+                if (words[i] != words[0] * (i + 1)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::array< std::uint64_t, 8 > words {};
+    };
+
+} // namespace test_helpers
+
+namespace test {
+
+    bool TestLoadStore() {
+        mr::atomic_any cell;
+        TEST_ASSERT(!cell.load()->has_value())
+
+        cell.store(mr::any { 1 });
+        auto first = cell.load();
+        TEST_ASSERT(mr::any_cast< int >(*first) == 1)
+
+        auto previous = cell.exchange(mr::any { 2 });
+        TEST_ASSERT(previous == first)
+        TEST_ASSERT(mr::any_cast< int >(*cell.load()) == 2)
+
+        // expected is stale, the exchange fails and expected is refreshed
+        TEST_ASSERT(!cell.compare_exchange(first, mr::any { 3 }))
+        TEST_ASSERT(mr::any_cast< int >(*first) == 2)
+
+        TEST_ASSERT(cell.compare_exchange(first, mr::any { 3 }))
+        TEST_ASSERT(mr::any_cast< int >(*cell.load()) == 3)
+        TEST_ASSERT(mr::any_cast< int >(*first) == 2)
+
+        return true;
+    }
+
+    bool TestSnapshotOutlivesStore() {
+        {
+            mr::atomic_any cell { mr::any { test_helpers::Payload { 1 } } };
+
+            auto held = cell.load();
+            cell.store(mr::any { test_helpers::Payload { 2 } });
+            cell.store(mr::any { test_helpers::Payload { 3 } });
+
+            // Payload 2 is gone, payload 1 is pinned by held and payload 3 is current
+            TEST_ASSERT(test_helpers::Live_payloads == 2)
+            TEST_ASSERT(mr::any_cast< const test_helpers::Payload& >(*held).sequence() == 1)
+
+            held.reset();
+            TEST_ASSERT(test_helpers::Live_payloads == 1)
+        }
+        TEST_ASSERT(test_helpers::Live_payloads == 0)
+
+        return true;
+    }
+
+    bool TestConcurrentReaders() {
+        constexpr std::uint64_t Stores  = 20'000;
+        constexpr int           Readers = 4;
+
+        {
+            mr::atomic_any      cell { mr::any { test_helpers::Payload { 0 } } };
+            std::atomic< bool > done { false };
+            std::atomic< bool > failed { false };
+
+            std::vector< std::thread > readers;
+            for (int i = 0; i < Readers; ++i) {
+                readers.emplace_back([&] {
+                    std::uint64_t last = 0;
+                    while (!done.load(std::memory_order_relaxed)) {
+                        const auto  current = cell.load();
+                        const auto* payload = mr::any_cast< test_helpers::Payload >(std::addressof(*current));
+                        if (!payload || !payload->is_consistent() || payload->sequence() < last) {
+                            failed = true;
+                        } else {
+                            last = payload->sequence();
+                        }
+                    }
+                });
+            }
+
+            for (std::uint64_t seq = 1; seq <= Stores; ++seq) {
+                cell.store(mr::any { test_helpers::Payload { seq } });
+            }
+            done = true;
+
+            for (auto& reader : readers) {
+                reader.join();
+            }
+            TEST_ASSERT(!failed)
+            TEST_ASSERT(mr::any_cast< const test_helpers::Payload& >(*cell.load()).sequence() == Stores)
+        }
+        TEST_ASSERT(test_helpers::Live_payloads == 0)
+
+        return true;
+    }
+
+    bool TestConcurrentCompareExchange() {
+        constexpr int Writers    = 4;
+        constexpr int Increments = 2'000;
+
+        mr::atomic_any             cell { mr::any { 0 } };
+        std::vector< std::thread > writers;
+        for (int i = 0; i < Writers; ++i) {
+            writers.emplace_back([&] {
+                for (int n = 0; n < Increments; ++n) {
+                    auto expected = cell.load();
+                    while (!cell.compare_exchange(expected, mr::any { mr::any_cast< int >(*expected) + 1 })) {
+                    }
+                }
+            });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+
+        TEST_ASSERT(mr::any_cast< int >(*cell.load()) == Writers * Increments)
+        return true;
+    }
+
+} // namespace test
+
+int main() {
+    static_assert(mr::atomic_any::is_always_lock_free());
+
+    assert(test::TestLoadStore());
+    assert(test::TestSnapshotOutlivesStore());
+    assert(test::TestConcurrentReaders());
+    assert(test::TestConcurrentCompareExchange());
+}
@@ -0,0 +1,210 @@
+#include <array>
+#include <atomic>
+#include <callback_queue.h>
+#include <cassert>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#define TEST_ASSERT(x) \
+    if (!(x)) {        \
+        return false;  \
+    }
+
+namespace test {
+
+    template < class Queue >
+    bool TestFifoOrder() {
+        Queue queue { 5 };
+        TEST_ASSERT(queue.capacity() == 8)
+        TEST_ASSERT(queue.empty())
+
+        std::vector< int > seen {};
+        for (int i = 0; i < 8; ++i) {
+            TEST_ASSERT(queue.try_push([&seen, i] { seen.push_back(i); }))
+        }
+        TEST_ASSERT(!queue.try_push([&seen] { seen.push_back(-1); }))
+        TEST_ASSERT(queue.size() == 8)
+
+        TEST_ASSERT(queue.drain(3) == 3)
+        TEST_ASSERT(seen.size() == 3 && seen[0] == 0 && seen[2] == 2)
+
+        // the slots released by the drain are reused
+        TEST_ASSERT(queue.try_push([&seen] { seen.push_back(8); }))
+        TEST_ASSERT(queue.drain(100) == 6)
+        TEST_ASSERT(queue.drain(100) == 0)
+        for (int i = 0; i < 9; ++i) {
+            TEST_ASSERT(seen[i] == i)
+        }
+
+        // empty callables are not queued
+        void (*null)() = nullptr;
+        TEST_ASSERT(queue.try_push(null))
+        TEST_ASSERT(queue.empty())
+        return true;
+    }
+
+    struct Tracked {
+        Tracked(int& live) : live(&live) {
+            ++live;
+        }
+        Tracked(const Tracked& other) : live(other.live) {
+            ++*live;
+        }
+        ~Tracked() {
+            --*live;
+        }
+
+        int* live;
+    };
+
+    // Payload decides whether the callback fits the slot or goes to the heap
+    template < std::size_t Payload >
+    bool TestLifetime() {
+        int live  = 0;
+        int calls = 0;
+        {
+            mr::callback_queue< void() > queue { 4 };
+            for (int i = 0; i < 3; ++i) {
+                queue.try_push([tracked = Tracked { live }, padding = std::array< char, Payload > {}, &calls] {
+                    ++calls;
+                });
+            }
+            TEST_ASSERT(live == 3)
+            TEST_ASSERT(queue.drain(1) == 1)
+            TEST_ASSERT(calls == 1 && live == 2)
+        }
+        // never drained callbacks are destroyed with the queue
+        TEST_ASSERT(calls == 1 && live == 0)
+        return true;
+    }
+
+    struct Adder {
+        Adder(int value) : value(value) {
+        }
+
+        void operator()(int& sum, const std::unique_ptr< int >& scale) const {
+            sum += value * *scale;
+        }
+
+        int value;
+    };
+
+    bool TestArgumentsAndEmplace() {
+        mr::spsc_callback_queue< void(int&, const std::unique_ptr< int >&) > queue { 8 };
+        TEST_ASSERT(queue.try_emplace< Adder >(1))
+        TEST_ASSERT(queue.try_emplace< Adder >(2))
+        TEST_ASSERT(queue.try_push([owned = std::make_unique< int >(3)](int& sum, const std::unique_ptr< int >& scale) {
+            sum += *owned * *scale;
+        }))
+
+        // every callback of a drain receives the same arguments
+        int sum = 0;
+        TEST_ASSERT(queue.drain(3, sum, std::make_unique< int >(10)) == 3)
+        TEST_ASSERT(sum == 60)
+        return true;
+    }
+
+    template < class Queue >
+    bool TestThrowingCallback() {
+        Queue queue { 4 };
+        int   live  = 0;
+        int   calls = 0;
+        queue.try_push([&calls] { ++calls; });
+        queue.try_push([tracked = Tracked { live }]() -> void { throw std::runtime_error { "callback" }; });
+        queue.try_push([&calls] { ++calls; });
+
+        bool thrown = false;
+        try {
+            queue.drain(3);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        // the throwing callback was destroyed and its slot released, the next one is still queued
+        TEST_ASSERT(thrown && calls == 1 && live == 0)
+        TEST_ASSERT(queue.drain(3) == 1 && calls == 2)
+        return true;
+    }
+
+    bool TestSingleProducerThread() {
+        constexpr long long Count = 200000;
+
+        mr::spsc_callback_queue< void() > queue { 64 };
+        unsigned long long                sum      = 0;
+        unsigned long long                expected = 0;
+
+        std::thread producer { [&queue, &sum] {
+            for (long long i = 0; i < Count; ++i) {
+                // consecutive values, so any reordering or loss changes the sum
+                queue.push([&sum, i] { sum = sum * 3 + static_cast< unsigned long long >(i); });
+            }
+        } };
+        for (long long drained = 0; drained < Count;) {
+            const std::size_t count = queue.drain(16);
+            drained += static_cast< long long >(count);
+            if (count == 0) {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+
+        for (long long i = 0; i < Count; ++i) {
+            expected = expected * 3 + static_cast< unsigned long long >(i);
+        }
+        TEST_ASSERT(sum == expected)
+        return true;
+    }
+
+    bool TestMultipleProducerThreads() {
+        constexpr int Producers = 4;
+        constexpr int Count     = 50000;
+
+        mr::callback_queue< void() > queue { 128 };
+        std::array< int, Producers > last {};
+        bool                         ordered = true;
+
+        std::vector< std::thread > producers {};
+        for (int p = 0; p < Producers; ++p) {
+            producers.emplace_back([&, p] {
+                for (int i = 1; i <= Count; ++i) {
+                    queue.push([&, p, i] {
+                        // each producer's callbacks are drained in the order it pushed them
+                        ordered = ordered && last[p] + 1 == i;
+                        last[p] = i;
+                    });
+                }
+            });
+        }
+        for (long long drained = 0; drained < static_cast< long long >(Producers) * Count;) {
+            const std::size_t count = queue.drain(32);
+            drained += static_cast< long long >(count);
+            if (count == 0) {
+                std::this_thread::yield();
+            }
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        TEST_ASSERT(ordered)
+        for (const int value : last) {
+            TEST_ASSERT(value == Count)
+        }
+        TEST_ASSERT(queue.empty())
+        return true;
+    }
+
+} // namespace test
+
+int main() {
+    assert(test::TestFifoOrder< mr::callback_queue< void() > >());
+    assert(test::TestFifoOrder< mr::spsc_callback_queue< void() > >());
+    assert(test::TestLifetime< 1 >());
+    assert(test::TestLifetime< 128 >());
+    assert(test::TestArgumentsAndEmplace());
+    assert(test::TestThrowingCallback< mr::callback_queue< void() > >());
+    assert(test::TestThrowingCallback< mr::spsc_callback_queue< void() > >());
+    assert(test::TestSingleProducerThread());
+    assert(test::TestMultipleProducerThreads());
+}
@@ -0,0 +1,88 @@
+// Paired functions compiled to assembly only, never linked. Each mr_<name> must generate the same code as, or at most a
+// few instructions more than, its std_<name> counterpart, see source.cpp for the allowed deltas.
+
+#include <any>
+#include <constexpr_any.h>
+#include <constexpr_function.h>
+#include <functional>
+#include <new>
+#include <utility>
+
+struct Small {
+    int a;
+    int b;
+};
+
+extern "C" {
+
+const int* mr_any_cast_pointer(const mr::any& value) {
+    return mr::any_cast< int >(&value);
+}
+const int* std_any_cast_pointer(const std::any& value) {
+    return std::any_cast< int >(&value);
+}
+
+int mr_any_cast_value(const mr::any& value) {
+    return mr::any_cast< int >(value);
+}
+int std_any_cast_value(const std::any& value) {
+    return std::any_cast< int >(value);
+}
+
+bool mr_any_has_value(const mr::any& value) {
+    return value.has_value();
+}
+bool std_any_has_value(const std::any& value) {
+    return value.has_value();
+}
+
+void mr_any_construct(void* where, Small value) {
+    ::new (where) mr::any(value);
+}
+void std_any_construct(void* where, Small value) {
+    ::new (where) std::any(value);
+}
+
+void mr_any_move(void* where, mr::any& value) {
+    ::new (where) mr::any(std::move(value));
+}
+void std_any_move(void* where, std::any& value) {
+    ::new (where) std::any(std::move(value));
+}
+
+void mr_any_reset(mr::any& value) {
+    value.reset();
+}
+void std_any_reset(std::any& value) {
+    value.reset();
+}
+
+int mr_function_call(const mr::function< int(int) >& fn, int value) {
+    return fn(value);
+}
+int std_function_call(const std::function< int(int) >& fn, int value) {
+    return fn(value);
+}
+
+void mr_function_construct(void* where, Small value) {
+    ::new (where) mr::function< int(int) >([value](int x) { return x + value.a * value.b; });
+}
+void std_function_construct(void* where, Small value) {
+    ::new (where) std::function< int(int) >([value](int x) { return x + value.a * value.b; });
+}
+
+void mr_function_move(void* where, mr::function< int(int) >& fn) {
+    ::new (where) mr::function< int(int) >(std::move(fn));
+}
+void std_function_move(void* where, std::function< int(int) >& fn) {
+    ::new (where) std::function< int(int) >(std::move(fn));
+}
+
+void mr_function_destroy(mr::function< int(int) >& fn) {
+    std::destroy_at(&fn);
+}
+void std_function_destroy(std::function< int(int) >& fn) {
+    std::destroy_at(&fn);
+}
+
+} // extern "C"
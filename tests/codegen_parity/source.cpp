@@ -0,0 +1,127 @@
+// Compares the assembly of the paired functions in parity.cpp, compiled with -S at several optimization levels. For
+// every pair the instructions of the mr_ and std_ versions are counted after normalization, and the test fails when
+// the mr_ one exceeds the allowed delta. Bodies are printed on failure to see what changed.
+// Usage: codegen_parity <assembly file>...
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define TEST_ASSERT(x) \
+    if (!(x)) {        \
+        return false;  \
+    }
+
+namespace test {
+
+    struct parity_pair {
+        std::string_view name;
+        int              allowed_delta;
+    };
+
+    // mr::any forwards to std::any at run-time, its std::is_constant_evaluated() branches must fold away entirely.
+    // Only its move costs more, it resets the source, which std::any leaves in a valid but unspecified state.
+    // mr::function is its own implementation, its budget is what it costs over std::function with GCC 12 on x86-64:
+    // one more table pointer to store, and a move through the erased Move operation instead of a byte copy. The test
+    // is only registered for that toolchain.
+    constexpr parity_pair pairs[] = {
+        { "any_cast_pointer", 0 },  { "any_cast_value", 0 },     { "any_has_value", 0 },
+        { "any_construct", 0 },     { "any_move", 11 },          { "any_reset", 0 },
+        { "function_call", 0 },     { "function_construct", 3 }, { "function_move", 18 },
+        { "function_destroy", 0 },
+    };
+
+    using assembly = std::map< std::string, std::vector< std::string >, std::less<> >;
+
+    std::string trim(std::string_view line) {
+        const auto first = line.find_first_not_of(" \t");
+        if (first == std::string_view::npos) {
+            return {};
+        }
+        const auto last = line.find_last_not_of(" \t");
+        return std::string { line.substr(first, last - first + 1) };
+    }
+
+    // Instructions of every function, without directives, comments and labels, local labels renamed to .L
+    assembly parse(const std::string& path) {
+        assembly      functions {};
+        std::ifstream in { path };
+        std::string   current {};
+        for (std::string raw; std::getline(in, raw);) {
+            std::string line = trim(raw.substr(0, raw.find('#')));
+            if (line.empty()) {
+                continue;
+            }
+            if (line.back() == ':') {
+                if (line[0] != '.') {
+                    current = line.substr(0, line.size() - 1);
+                    functions[current];
+                }
+                continue;
+            }
+            if (line[0] == '.') {
+                if (line.starts_with(".size") || line.starts_with(".cfi_endproc")) {
+                    current.clear();
+                }
+                continue;
+            }
+            if (!current.empty()) {
+                for (auto at = line.find(".L"); at != std::string::npos; at = line.find(".L", at + 2)) {
+                    auto end = at + 2;
+                    while (end < line.size() && (std::isalnum(static_cast< unsigned char >(line[end])) ||
+                                                 line[end] == '_')) {
+                        ++end;
+                    }
+                    line.replace(at, end - at, ".L");
+                }
+                functions[current].push_back(line);
+            }
+        }
+        return functions;
+    }
+
+    void print_body(std::string_view name, const std::vector< std::string >& body) {
+        std::printf("  %.*s:\n", static_cast< int >(name.size()), name.data());
+        for (const std::string& line : body) {
+            std::printf("    %s\n", line.c_str());
+        }
+    }
+
+    bool TestParity(const std::string& path) {
+        const assembly functions = parse(path);
+        bool           passed    = true;
+        std::printf("%s\n%-20s %6s %6s %6s %8s\n", path.c_str(), "pair", "mr", "std", "delta", "allowed");
+        for (const parity_pair& pair : pairs) {
+            const std::string mr_name  = "mr_" + std::string { pair.name };
+            const std::string std_name = "std_" + std::string { pair.name };
+            const auto        mr_it    = functions.find(mr_name);
+            const auto        std_it   = functions.find(std_name);
+            TEST_ASSERT(mr_it != functions.end() && std_it != functions.end())
+
+            const int mr_count  = static_cast< int >(mr_it->second.size());
+            const int std_count = static_cast< int >(std_it->second.size());
+            const int delta     = mr_count - std_count;
+            std::printf("%-20.*s %6d %6d %+6d %8d%s\n", static_cast< int >(pair.name.size()), pair.name.data(),
+                        mr_count, std_count, delta, pair.allowed_delta, delta > pair.allowed_delta ? "  FAIL" : "");
+            if (delta > pair.allowed_delta) {
+                print_body(mr_name, mr_it->second);
+                print_body(std_name, std_it->second);
+                passed = false;
+            }
+        }
+        return passed;
+    }
+
+} // namespace test
+
+int main(int argc, char** argv) {
+    bool passed = argc > 1;
+    for (int i = 1; i < argc; ++i) {
+        passed = test::TestParity(argv[i]) && passed;
+    }
+    return passed ? 0 : 1;
+}
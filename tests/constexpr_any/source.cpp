@@ -363,21 +363,28 @@ static_assert(test::CastTests< std::vector< int > >());
 #endif // __cpp_lib_constexpr_vector
 static_assert(test::CastTests< std::array< int, 10 > >());
 
-static_assert(test::GetMaxValues< int >({ 1, 2, 3, 4, 9, 5, 6 }) == 9);
-static_assert(test::GetMaxValues< std::uint64_t >({ std::uint64_t { 10 }, std::uint64_t { 2 }, std::uint64_t { 31 },
-                                                    std::uint64_t { 44 }, std::uint64_t { 19 }, std::uint64_t { 75 },
-                                                    std::uint64_t { 46 } }) == std::uint64_t { 75 });
+// Temporaries are materialized inside a lambda, GCC 12 rejects comparing their address to nullptr when they are
+// created directly in the static_assert condition. That happens for the array behind the initializer_list of
+// GetMaxValues, and in the pointer any_cast overloads used by Strlen.
+static_assert([] { return test::GetMaxValues< int >({ 1, 2, 3, 4, 9, 5, 6 }) == 9; }());
+static_assert([] {
+    return test::GetMaxValues< std::uint64_t >({ std::uint64_t { 10 }, std::uint64_t { 2 }, std::uint64_t { 31 },
+                                                 std::uint64_t { 44 }, std::uint64_t { 19 }, std::uint64_t { 75 },
+                                                 std::uint64_t { 46 } }) == std::uint64_t { 75 };
+}());
 
-static_assert(test::Strlen< const char* >("this is const char* string") == 26);
+static_assert([] { return test::Strlen< const char* >("this is const char* string") == 26; }());
 namespace {
     using namespace std::literals::string_view_literals;
-    static_assert(test::Strlen< std::string_view >("this is std::string_view string"sv) == 31);
+    static_assert([] { return test::Strlen< std::string_view >("this is std::string_view string"sv) == 31; }());
 } // namespace
 
 #ifdef __cpp_lib_constexpr_string
-static_assert(test::Strlen< std::string >(std::string { "small string" }) == 12);
-static_assert(test::Strlen< std::string >(std::string {
-                  "A large string that will not fit into a small string optimization!" }) == 66);
+static_assert([] { return test::Strlen< std::string >(std::string { "small string" }) == 12; }());
+static_assert([] {
+    return test::Strlen< std::string >(
+               std::string { "A large string that will not fit into a small string optimization!" }) == 66;
+}());
 #endif // __cpp_lib_constexpr_string
 
 int main() {
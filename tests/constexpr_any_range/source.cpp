@@ -0,0 +1,169 @@
+#include <array>
+#include <cassert>
+#include <constexpr_any_range.h>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#define CONSTEXPR_ASSERT(x) \
+    if (!(x)) {             \
+        return false;       \
+    }
+
+namespace test {
+
+    // Across a module boundary: the consumer only sees any_range<int>
+    constexpr int Sum(mr::any_range< int > range) {
+        int sum = 0;
+        for (const int value : range) {
+            sum += value;
+        }
+        return sum;
+    }
+
+    constexpr int SumChunked(mr::any_range< int > range, std::size_t chunk) {
+        std::vector< int > buffer(chunk);
+        int                sum = 0;
+        auto               it  = range.begin();
+        for (std::size_t count = it.next_chunk(buffer); count != 0; count = it.next_chunk(buffer)) {
+            for (std::size_t i = 0; i < count; ++i) {
+                sum += buffer[i];
+            }
+        }
+        return sum;
+    }
+
+    constexpr bool TestIteration() {
+        std::vector< int > values { 1, 2, 3, 4, 5 };
+
+        // lvalue ranges are referenced
+        CONSTEXPR_ASSERT(Sum(values) == 15)
+        values.push_back(6);
+        CONSTEXPR_ASSERT(Sum(values) == 21)
+
+        // rvalue ranges are owned, views are stored as is
+        CONSTEXPR_ASSERT(Sum(std::vector< int > { 10, 20 }) == 30)
+        CONSTEXPR_ASSERT(Sum(std::views::iota(1, 101)) == 5050)
+        CONSTEXPR_ASSERT(Sum(values | std::views::filter([](int v) { return v % 2 == 0; })) == 12)
+
+        // elements convert to T
+        const std::array< short, 3 > shorts { 7, 8, 9 };
+        CONSTEXPR_ASSERT(Sum(shorts) == 24)
+
+        CONSTEXPR_ASSERT(Sum(mr::any_range< int > {}) == 0)
+        return true;
+    }
+
+    constexpr bool TestChunks() {
+        // every chunk size, including ones not dividing the length
+        for (std::size_t chunk = 1; chunk <= 8; ++chunk) {
+            CONSTEXPR_ASSERT(SumChunked(std::views::iota(1, 101), chunk) == 5050)
+        }
+
+        // element-wise and chunked iteration mix
+        std::vector< int >    values { 1, 2, 3, 4, 5, 6, 7 };
+        mr::any_range< int >  range { values };
+        auto                  it = range.begin();
+        std::array< int, 3 > buffer {};
+        CONSTEXPR_ASSERT(*it == 1)
+        ++it;
+        CONSTEXPR_ASSERT(it.next_chunk(buffer) == 3 && buffer[0] == 2 && buffer[2] == 4)
+        CONSTEXPR_ASSERT(*it == 5)
+        CONSTEXPR_ASSERT(it.next_chunk(buffer) == 3 && buffer[0] == 5 && buffer[2] == 7)
+        CONSTEXPR_ASSERT(it == std::default_sentinel)
+        CONSTEXPR_ASSERT(it.next_chunk(buffer) == 0)
+
+        // a range can be walked again
+        auto again = range.begin();
+        CONSTEXPR_ASSERT(*again == 1)
+        return true;
+    }
+
+    constexpr bool TestIteratorPair() {
+        const std::string text { "erased" };
+
+        mr::any_iterator< char > it { text.begin(), text.end() };
+        mr::any_iterator< char > moved { std::move(it) };
+        CONSTEXPR_ASSERT(it == std::default_sentinel)
+
+        std::string copy {};
+        for (; moved != std::default_sentinel; ++moved) {
+            copy += *moved;
+        }
+        CONSTEXPR_ASSERT(copy == text)
+        return true;
+    }
+
+    // Elements with a non-trivial lifetime, and a range larger than the inline storage
+    bool TestOwnedElements() {
+        std::array< std::string, 8 > words { "a", "b", "c", "d", "e", "f", "g", "h" };
+        static_assert(!mr::sbo_storage<>::stores_inline_v< std::views::all_t< std::array< std::string, 8 > > >,
+                      "Incorrect behaviour: the owned array must be kept in a heap node");
+
+        mr::any_range< std::string > range { std::move(words) };
+        mr::any_range< std::string > moved { std::move(range) };
+        CONSTEXPR_ASSERT(!range && moved)
+
+        std::string joined {};
+        for (const std::string& word : moved) {
+            joined += word;
+        }
+        CONSTEXPR_ASSERT(joined == "abcdefgh")
+
+        std::array< std::string, 3 > chunk {};
+        auto                         it = moved.begin();
+        CONSTEXPR_ASSERT(it.next_chunk(chunk) == 3 && chunk[2] == "c")
+        return true;
+    }
+
+    // Moves throw once Fail is set
+    struct ThrowingMove {
+        static inline bool Fail = false;
+
+        ThrowingMove() = default;
+        ThrowingMove(const ThrowingMove&) = default;
+        ThrowingMove(ThrowingMove&&) {
+            if (Fail) {
+                throw std::runtime_error { "ThrowingMove" };
+            }
+        }
+        ThrowingMove& operator=(const ThrowingMove&) = default;
+        ThrowingMove& operator=(ThrowingMove&&)      = default;
+    };
+
+    static_assert(std::is_nothrow_move_constructible_v< mr::any_iterator< int > >);
+    static_assert(std::is_nothrow_move_assignable_v< mr::any_iterator< int > >);
+    static_assert(!std::is_nothrow_move_constructible_v< mr::any_iterator< ThrowingMove > >);
+    static_assert(!std::is_nothrow_move_assignable_v< mr::any_iterator< ThrowingMove > >);
+
+    // A throwing element move propagates out of the iterator move instead of terminating
+    bool TestThrowingElementMove() {
+        std::array< ThrowingMove, 2 >    values {};
+        mr::any_iterator< ThrowingMove > it { values.begin(), values.end() };
+        ThrowingMove::Fail = true;
+        bool thrown        = false;
+        try {
+            mr::any_iterator< ThrowingMove > moved { std::move(it) };
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        ThrowingMove::Fail = false;
+        return thrown;
+    }
+
+} // namespace test
+
+static_assert(test::TestIteration());
+static_assert(test::TestChunks());
+static_assert(test::TestIteratorPair());
+
+int main() {
+    assert(test::TestIteration());
+    assert(test::TestChunks());
+    assert(test::TestIteratorPair());
+    assert(test::TestOwnedElements());
+    assert(test::TestThrowingElementMove());
+}
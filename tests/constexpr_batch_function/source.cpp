@@ -0,0 +1,139 @@
+#include <array>
+#include <cassert>
+#include <constexpr_batch_function.h>
+#include <functional>
+#include <span>
+#include <stdexcept>
+
+#define CONSTEXPR_ASSERT(x) \
+    if (!(x)) {             \
+        return false;       \
+    }
+
+namespace test {
+
+    constexpr float Twice(float value) noexcept {
+        return value * 2.f;
+    }
+
+    struct Saxpy {
+        constexpr float operator()(float x, float y) const noexcept {
+            return a * x + y;
+        }
+
+        float a;
+    };
+
+    // Already span-at-a-time, used as is
+    struct NativeBatch {
+        constexpr void operator()(std::span< int > out, std::span< const int > in) const {
+            for (std::size_t i = 0; i < out.size(); ++i) {
+                out[i] = in[i] + offset;
+            }
+        }
+
+        int offset;
+    };
+
+    constexpr bool TestScalarAdaptation() {
+        std::array< float, 5 > in { 1.f, 2.f, 3.f, 4.f, 5.f };
+        std::array< float, 5 > out {};
+
+        // function pointer
+        {
+            mr::batch_function< float(float) > f { Twice };
+            f(out, in);
+            CONSTEXPR_ASSERT(out[0] == 2.f && out[4] == 10.f)
+            CONSTEXPR_ASSERT(f(3.f) == 6.f)
+            CONSTEXPR_ASSERT(*f.target< float (*)(float) noexcept >() == Twice)
+        }
+
+        // lambda
+        {
+            mr::batch_function< float(float) > f = [](float value) { return value + 1.f; };
+            f(out, in);
+            CONSTEXPR_ASSERT(out[0] == 2.f && out[4] == 6.f)
+        }
+
+        // function object with several inputs
+        {
+            std::array< float, 5 > y { 10.f, 10.f, 10.f, 10.f, 10.f };
+
+            mr::batch_function< float(float, float) > f = Saxpy { 3.f };
+            f(out, in, y);
+            CONSTEXPR_ASSERT(out[0] == 13.f && out[4] == 25.f)
+            CONSTEXPR_ASSERT(f.target< Saxpy >()->a == 3.f)
+        }
+
+        // an erased scalar function is adapted as well
+        {
+            mr::function< float(float) >       scalar = Twice;
+            mr::batch_function< float(float) > f      = scalar;
+            f(std::span { out }.first(2), in);
+            CONSTEXPR_ASSERT(out[0] == 2.f && out[1] == 4.f)
+        }
+
+        return true;
+    }
+
+    constexpr bool TestNativeBatch() {
+        std::array< int, 3 > in { 1, 2, 3 };
+        std::array< int, 3 > out {};
+
+        mr::batch_function< int(int) > f = NativeBatch { 10 };
+        f(out, in);
+        CONSTEXPR_ASSERT(out[0] == 11 && out[2] == 13)
+        CONSTEXPR_ASSERT(f.target< NativeBatch >()->offset == 10)
+
+        return true;
+    }
+
+    constexpr bool TestCopyMoveSwap() {
+        std::array< int, 2 > in { 1, 2 };
+        std::array< int, 2 > out {};
+
+        mr::batch_function< int(int) > f1 = [](int value) { return value * 10; };
+        mr::batch_function< int(int) > f2 = f1;
+        CONSTEXPR_ASSERT(f2(4) == 40)
+
+        mr::batch_function< int(int) > f3 { std::move(f1) };
+        CONSTEXPR_ASSERT(!f1)
+        f3(out, in);
+        CONSTEXPR_ASSERT(out[1] == 20)
+
+        mr::batch_function< int(int) > f4 = NativeBatch { 1 };
+        f4.swap(f3);
+        CONSTEXPR_ASSERT(f3(1) == 2)
+        CONSTEXPR_ASSERT(f4(1) == 10)
+
+        mr::batch_function< int(int) > empty = static_cast< int (*)(int) >(nullptr);
+        CONSTEXPR_ASSERT(!empty)
+
+        return true;
+    }
+
+    bool TestShortInputThrows() {
+        std::array< int, 2 > in { 1, 2 };
+        std::array< int, 3 > out {};
+
+        mr::batch_function< int(int) > f = [](int value) { return value; };
+        try {
+            f(out, in);
+        } catch (const std::length_error&) {
+            return true;
+        }
+        return false;
+    }
+
+} // namespace test
+
+static_assert(test::TestScalarAdaptation());
+static_assert(test::TestNativeBatch());
+static_assert(test::TestCopyMoveSwap());
+
+int main() {
+    assert(test::TestScalarAdaptation());
+    assert(test::TestNativeBatch());
+    assert(test::TestCopyMoveSwap());
+    assert(test::TestShortInputThrows());
+}
@@ -0,0 +1,111 @@
+#include <array>
+#include <cassert>
+#include <constexpr_cached_call.h>
+#include <functional>
+
+#define CONSTEXPR_ASSERT(x) \
+    if (!(x)) {             \
+        return false;       \
+    }
+
+namespace test {
+
+    struct Add {
+        constexpr int operator()(int x) const {
+            return x + value;
+        }
+
+        int value;
+    };
+
+    struct Mul {
+        constexpr int operator()(int x) const {
+            return x * value;
+        }
+
+        int value;
+    };
+
+    // Counts its calls, the direct path must invoke the stored object, not a copy
+    struct Counter {
+        constexpr int operator()(int x) {
+            return x + ++calls;
+        }
+
+        int calls { 0 };
+    };
+
+    constexpr int Negate(int x) {
+        return -x;
+    }
+
+    // holds and target identify the target with the same check
+    template < class Callable, class F >
+    constexpr bool HoldsAgrees(const F& fn) {
+        return fn.template holds< Callable >() == (fn.template target< Callable >() != nullptr);
+    }
+
+    constexpr bool TestInvokeAs() {
+        mr::function< int(int) > fn = Add { 2 };
+        CONSTEXPR_ASSERT(fn.holds< Add >() && !fn.holds< Mul >())
+        CONSTEXPR_ASSERT(HoldsAgrees< Add >(fn) && HoldsAgrees< Mul >(fn))
+        CONSTEXPR_ASSERT(fn.invoke_as< Add >(1) == 3)
+
+        // a wrong guess still calls the target, through the erased call
+        CONSTEXPR_ASSERT(fn.invoke_as< Mul >(1) == 3)
+
+        fn = Counter {};
+        CONSTEXPR_ASSERT(fn.invoke_as< Counter >(10) == 11 && fn(10) == 12 && fn.invoke_as< Counter >(10) == 13)
+        CONSTEXPR_ASSERT(fn.target< Counter >()->calls == 3)
+
+        fn = Negate;
+        CONSTEXPR_ASSERT(fn.holds< int (*)(int) >() && fn.invoke_as< int (*)(int) >(4) == -4)
+
+        mr::function< int(int) > empty {};
+        CONSTEXPR_ASSERT(!empty.holds< Add >() && HoldsAgrees< Add >(empty))
+        CONSTEXPR_ASSERT(HoldsAgrees< int (*)(int) >(fn) && HoldsAgrees< Counter >(fn))
+        return true;
+    }
+
+    constexpr bool TestCachedCall() {
+        mr::cached_call< Add, Mul > site {};
+        CONSTEXPR_ASSERT(site.last_index() == 2)
+
+        const mr::function< int(int) > add = Add { 1 };
+        const mr::function< int(int) > mul = Mul { 3 };
+        const mr::function< int(int) > neg = Negate;
+
+        CONSTEXPR_ASSERT(site(add, 1) == 2 && site.last_index() == 0)
+        CONSTEXPR_ASSERT(site(add, 2) == 3 && site.last_index() == 0)
+        CONSTEXPR_ASSERT(site(mul, 2) == 6 && site.last_index() == 1)
+        CONSTEXPR_ASSERT(site(add, 3) == 4 && site.last_index() == 0)
+
+        // types that are not candidates take the erased call
+        CONSTEXPR_ASSERT(site(neg, 5) == -5 && site.last_index() == 2)
+        CONSTEXPR_ASSERT(site(mul, 1) == 3 && site.last_index() == 1)
+        return true;
+    }
+
+    bool TestEmpty() {
+        mr::cached_call< Add > site {};
+        const mr::function< int(int) > empty {};
+        bool                           thrown = false;
+        try {
+            (void)site(empty, 1);
+        } catch (const std::bad_function_call&) {
+            thrown = true;
+        }
+        CONSTEXPR_ASSERT(thrown && site.last_index() == 1)
+        return true;
+    }
+
+} // namespace test
+
+static_assert(test::TestInvokeAs());
+static_assert(test::TestCachedCall());
+
+int main() {
+    assert(test::TestInvokeAs());
+    assert(test::TestCachedCall());
+    assert(test::TestEmpty());
+}
@@ -0,0 +1,133 @@
+#include <cassert>
+#include <constexpr_compose.h>
+#include <constexpr_function.h>
+#include <functional>
+
+#define CONSTEXPR_ASSERT(x) \
+    if (!(x)) {             \
+        return false;       \
+    }
+
+namespace test {
+
+    constexpr int Increment(int value) noexcept {
+        return value + 1;
+    }
+
+    struct Multiply {
+        constexpr int operator()(int value) const noexcept {
+            return value * factor;
+        }
+
+        int factor;
+    };
+
+    struct Counter {
+        constexpr int operator()(int value) {
+            return value + ++calls;
+        }
+
+        int calls = 0;
+    };
+
+    constexpr bool TestComposeKnownTypes() {
+        // compose applies right to left
+        auto f = mr::compose(Increment, Multiply { 3 }, [](int x, int y) { return x - y; });
+        CONSTEXPR_ASSERT(f(5, 1) == 13)
+
+        // different types between stages
+        auto g = mr::compose([](double value) { return static_cast< int >(value * 2); }, [](int value) {
+            return value + 0.25;
+        });
+        CONSTEXPR_ASSERT(g(1) == 2)
+
+        // nested compositions are spliced into one
+        auto h = mr::compose(Increment, f);
+        static_assert(std::tuple_size_v< std::remove_cvref_t< decltype(h.get_stages()) > > == 4);
+        CONSTEXPR_ASSERT(h(5, 1) == 14)
+
+        // stateful stages are mutated through the non-const call
+        auto counted = mr::compose(Counter {}, Increment);
+        CONSTEXPR_ASSERT(counted(1) == 3)
+        CONSTEXPR_ASSERT(counted(1) == 4)
+
+        return true;
+    }
+
+    constexpr bool TestErasedOnce() {
+        // one mr::function around the fused stages instead of one per stage
+        mr::function< int(int) > f = mr::compose(Increment, Multiply { 2 });
+        CONSTEXPR_ASSERT(f(4) == 9)
+
+        mr::function< int(int) > g = mr::pipeline {} | Increment | Multiply { 2 };
+        CONSTEXPR_ASSERT(g(4) == 10)
+
+        return true;
+    }
+
+    constexpr bool TestFlattenErased() {
+        mr::function< int(int) > inc    = Increment;
+        mr::function< int(int) > triple = Multiply { 3 };
+
+        // already erased stages become one chain held by one mr::function
+        mr::function< int(int) > f = mr::compose(inc, triple);
+        CONSTEXPR_ASSERT(f(2) == 7)
+
+        // composing a chain flattens it instead of nesting it
+        mr::function< int(int) > g     = mr::compose(triple, f, inc);
+        const auto*              chain = g.target< mr::detail::function_chain< int > >();
+        CONSTEXPR_ASSERT(chain != nullptr)
+        CONSTEXPR_ASSERT(chain->size() == 4)
+        CONSTEXPR_ASSERT(g(1) == 21)
+
+        // rvalue stages are moved in, a moved chain still flattens
+        mr::function< int(int) > moved = mr::compose(std::move(inc), std::move(g));
+        CONSTEXPR_ASSERT(!inc && moved(1) == 22)
+        CONSTEXPR_ASSERT(moved.target< mr::detail::function_chain< int > >()->size() == 5)
+
+        return true;
+    }
+
+    // Empty stages are kept, calling the chain fails like calling them
+    bool TestEmptyStage() {
+        mr::function< int(int) > inc = Increment;
+        mr::function< int(int) > empty {};
+        mr::function< int(int) > h   = mr::compose(inc, empty, inc);
+        CONSTEXPR_ASSERT(h.target< mr::detail::function_chain< int > >()->size() == 3)
+        try {
+            (void)h(0);
+        } catch (const std::bad_function_call&) {
+            return true;
+        }
+        return false;
+    }
+
+    constexpr bool TestPipeline() {
+        constexpr auto stages = mr::pipeline {} | Increment | Multiply { 10 };
+        static_assert(stages(1) == 20);
+
+        // pipelines appended to pipelines are spliced
+        auto longer = stages | (mr::pipeline {} | Increment | Increment);
+        static_assert(std::tuple_size_v< std::remove_cvref_t< decltype(longer.get_stages()) > > == 4);
+        CONSTEXPR_ASSERT(longer(1) == 22)
+
+        auto with_then = mr::pipeline {}.then([](int x) { return x * x; }).then(Increment);
+        CONSTEXPR_ASSERT(with_then(3) == 10)
+
+        return true;
+    }
+
+} // namespace test
+
+static_assert(test::TestComposeKnownTypes());
+static_assert(test::TestErasedOnce());
+static_assert(test::TestFlattenErased());
+static_assert(test::TestPipeline());
+
+int main() {
+    assert(test::TestComposeKnownTypes());
+    assert(test::TestErasedOnce());
+    assert(test::TestFlattenErased());
+    assert(test::TestEmptyStage());
+    assert(test::TestPipeline());
+}
@@ -0,0 +1,121 @@
+#include <cassert>
+#include <constexpr_dispatch_table.h>
+#include <functional>
+#include <string_view>
+
+#define CONSTEXPR_ASSERT(x) \
+    if (!(x)) {             \
+        return false;       \
+    }
+
+namespace test_helpers {
+
+    constexpr int Negate(int value) noexcept {
+        return -value;
+    }
+
+    struct Scale {
+        constexpr int operator()(int value) const noexcept {
+            return value * factor;
+        }
+
+        int factor;
+    };
+
+    enum class Opcode : std::uint8_t
+    {
+        Add,
+        Sub,
+        Mul,
+        Div,
+        Mod,
+    };
+
+    constexpr auto Commands = mr::make_dispatch_table< int(int) >(
+        mr::dispatch_entry { "negate", Negate }, mr::dispatch_entry { "double", Scale { 2 } },
+        mr::dispatch_entry { "triple", Scale { 3 } },
+        mr::dispatch_entry { "square", [](int value) { return value * value; } },
+        mr::dispatch_entry { "identity", [](int value) { return value; } });
+
+    constexpr auto Operations = mr::make_dispatch_table< int(int, int) >(
+        mr::dispatch_entry { Opcode::Add, std::plus< int > {} },
+        mr::dispatch_entry { Opcode::Sub, std::minus< int > {} },
+        mr::dispatch_entry { Opcode::Mul, std::multiplies< int > {} },
+        mr::dispatch_entry { Opcode::Div, std::divides< int > {} },
+        mr::dispatch_entry { Opcode::Mod, std::modulus< int > {} });
+
+} // namespace test_helpers
+
+namespace test {
+
+    constexpr bool TestStringKeys() {
+        using namespace std::literals::string_view_literals;
+
+        const auto& table = test_helpers::Commands;
+        CONSTEXPR_ASSERT(table.size() == 5)
+        CONSTEXPR_ASSERT(table("negate", 4) == -4)
+        CONSTEXPR_ASSERT(table("double", 4) == 8)
+        CONSTEXPR_ASSERT(table("triple"sv, 4) == 12)
+        CONSTEXPR_ASSERT(table("square", 4) == 16)
+        CONSTEXPR_ASSERT(table("identity", 4) == 4)
+
+        CONSTEXPR_ASSERT(table.contains("square"))
+        CONSTEXPR_ASSERT(!table.contains("cube"))
+        CONSTEXPR_ASSERT(!table.contains(""))
+
+        return true;
+    }
+
+    constexpr bool TestIntegralKeys() {
+        using test_helpers::Opcode;
+
+        const auto& table = test_helpers::Operations;
+        CONSTEXPR_ASSERT(table(Opcode::Add, 7, 3) == 10)
+        CONSTEXPR_ASSERT(table(Opcode::Sub, 7, 3) == 4)
+        CONSTEXPR_ASSERT(table(Opcode::Mul, 7, 3) == 21)
+        CONSTEXPR_ASSERT(table(Opcode::Div, 7, 3) == 2)
+        CONSTEXPR_ASSERT(table(Opcode::Mod, 7, 3) == 1)
+        CONSTEXPR_ASSERT(!table.contains(static_cast< Opcode >(42)))
+
+        return true;
+    }
+
+    template < int... Is >
+    constexpr bool TestManyKeys(std::integer_sequence< int, Is... >) {
+        const auto table = mr::make_dispatch_table< int() >(
+            mr::dispatch_entry { Is * 7919, [] { return Is; } }...);
+
+        CONSTEXPR_ASSERT(((table(Is * 7919) == Is) && ...))
+        CONSTEXPR_ASSERT(!table.contains(1))
+
+        return true;
+    }
+
+    bool TestUnknownKeyThrows() {
+        try {
+            (void)test_helpers::Commands("cube", 2);
+        } catch (const std::bad_function_call&) {
+            return true;
+        }
+        return false;
+    }
+
+} // namespace test
+
+static_assert(test::TestStringKeys());
+static_assert(test::TestIntegralKeys());
+static_assert(test::TestManyKeys(std::make_integer_sequence< int, 100 > {}));
+
+// Fully built during constant initialization, no start-up cost
+constinit auto Runtime_commands = mr::make_dispatch_table< int(int) >(
+    mr::dispatch_entry { "negate", test_helpers::Negate }, mr::dispatch_entry { "double", test_helpers::Scale { 2 } });
+
+int main() {
+    assert(test::TestStringKeys());
+    assert(test::TestIntegralKeys());
+    assert(test::TestManyKeys(std::make_integer_sequence< int, 100 > {}));
+    assert(test::TestUnknownKeyThrows());
+
+    assert(Runtime_commands("negate", 1) == -1);
+    assert(Runtime_commands("double", 21) == 42);
+}
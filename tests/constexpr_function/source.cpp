@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <constexpr_any.h>
 #include <constexpr_function.h>
@@ -187,6 +189,284 @@ namespace test {
         return true;
     }
 
+    // Counts live copies through a pointer so the same test runs with inline and heap storage
+    template < std::size_t Padding >
+    struct Tracked {
+        constexpr Tracked(int* Live) noexcept : live(Live) {
+            ++*live;
+        }
+        constexpr Tracked(const Tracked& Other) noexcept : live(Other.live) {
+            ++*live;
+        }
+        constexpr Tracked(Tracked&& Other) noexcept : live(Other.live) {
+            ++*live;
+        }
+        constexpr ~Tracked() {
+            --*live;
+        }
+
+        constexpr int operator()(int value) const noexcept {
+            return value + static_cast< int >(Padding);
+        }
+
+        int* live;
+        char padding[Padding] {};
+    };
+
+    template < std::size_t Padding >
+    constexpr bool TestStorage() {
+        int live = 0;
+        {
+            mr::function< int(int) > f1 = Tracked< Padding > { &live };
+            CONSTEXPR_ASSERT(live == 1)
+
+            mr::function< int(int) > f2 = f1;
+            CONSTEXPR_ASSERT(live == 2)
+            CONSTEXPR_ASSERT(f2(1) == 1 + static_cast< int >(Padding))
+
+            mr::function< int(int) > f3 = std::move(f1);
+            CONSTEXPR_ASSERT(!f1)
+            CONSTEXPR_ASSERT(live == 2)
+            CONSTEXPR_ASSERT(f3.target< Tracked< Padding > >() != nullptr)
+
+            mr::function< int(int) > f4 = [](int value) { return value; };
+            f4.swap(f3);
+            CONSTEXPR_ASSERT(f3.target< Tracked< Padding > >() == nullptr)
+            CONSTEXPR_ASSERT(f4(2) == 2 + static_cast< int >(Padding))
+
+            f2 = std::move(f4);
+            CONSTEXPR_ASSERT(live == 1)
+
+            f2 = nullptr;
+            CONSTEXPR_ASSERT(live == 0)
+        }
+        CONSTEXPR_ASSERT(live == 0)
+        return true;
+    }
+
+    struct Connection {
+        constexpr int Handle(int request, int flags) const noexcept {
+            return id * 100 + request * 10 + flags;
+        }
+
+        int id;
+    };
+
+    constexpr int Subtract(int lhs, int rhs) noexcept {
+        return lhs - rhs;
+    }
+
+    constexpr bool TestBind() {
+        CONSTEXPR_ASSERT(mr::bind_front(Subtract, 10)(3) == 7)
+        CONSTEXPR_ASSERT(mr::bind_back(Subtract, 10)(3) == -7)
+
+        // member function bound to an object pointer
+        const Connection conn { 4 };
+        mr::function< int(int) > handler = mr::bind_back(mr::bind_front(&Connection::Handle, &conn), 1);
+        CONSTEXPR_ASSERT(handler(2) == 421)
+
+        // nested bindings in the same direction are flattened
+        auto twice = mr::bind_front(mr::bind_front(&Connection::Handle, &conn), 3);
+        static_assert(std::is_same_v< decltype(twice), decltype(mr::bind_front(&Connection::Handle, &conn, 3)) >);
+        CONSTEXPR_ASSERT(twice(5) == 435)
+
+        auto back = mr::bind_back(mr::bind_back(Subtract, 1), 10);
+        CONSTEXPR_ASSERT(back() == 9)
+
+        // bound arguments are owned by the binding
+        mr::function< int() > f {};
+        {
+            std::vector< int > values { 1, 2, 3 };
+            f = mr::bind_front([](const std::vector< int >& v) { return static_cast< int >(v.size()); }, values);
+        }
+        CONSTEXPR_ASSERT(f() == 3)
+
+        // rvalue bindings forward their bound arguments as rvalues
+        auto sink = mr::bind_front([](std::vector< int >&& v) { return v.size(); }, std::vector< int >(4));
+        CONSTEXPR_ASSERT(std::move(sink)() == 4)
+
+        return true;
+    }
+
+    // A member function bound to an object pointer fits inline storage
+    static_assert(mr::sbo_storage<>::stores_inline_v<
+                  decltype(mr::bind_front(&Connection::Handle, std::declval< const Connection* >())) >);
+    static_assert(!mr::sbo_storage<>::stores_inline_v< Tracked< 64 > >);
+
+    template < class Storage, class Ownership >
+    constexpr bool TestPolicy() {
+        using Fn = mr::basic_function< int(int), Storage, Ownership >;
+
+        int live = 0;
+        {
+            Fn f1 = Tracked< 8 > { &live };
+            Fn f2 = f1;
+            CONSTEXPR_ASSERT(f2(1) == 9)
+            CONSTEXPR_ASSERT(live == (Ownership::is_shared ? 1 : 2))
+
+            Fn f3 = std::move(f1);
+            CONSTEXPR_ASSERT(!f1)
+            CONSTEXPR_ASSERT(f3.template target< Tracked< 8 > >() != nullptr)
+
+            f3 = [](int value) { return -value; };
+            CONSTEXPR_ASSERT(f3(1) == -1)
+            CONSTEXPR_ASSERT(live == 1)
+        }
+        CONSTEXPR_ASSERT(live == 0)
+        return true;
+    }
+
+    constexpr bool TestPolicies() {
+        CONSTEXPR_ASSERT((TestPolicy< mr::sbo_storage<>, mr::unique_ownership >()))
+        CONSTEXPR_ASSERT((TestPolicy< mr::sbo_storage< 8 >, mr::unique_ownership >()))
+        CONSTEXPR_ASSERT((TestPolicy< mr::heap_storage, mr::unique_ownership >()))
+        CONSTEXPR_ASSERT((TestPolicy< mr::inline_storage< 32 >, mr::unique_ownership >()))
+        CONSTEXPR_ASSERT((TestPolicy< mr::heap_storage, mr::shared_ownership< mr::local_refcount > >()))
+        CONSTEXPR_ASSERT((TestPolicy< mr::heap_storage, mr::shared_ownership< mr::atomic_refcount > >()))
+
+        // mr::function is basic_function with the default policies
+        mr::basic_function< int(int) > basic = [](int value) { return value * 2; };
+        mr::function< int(int) >       f     = basic;
+        CONSTEXPR_ASSERT(f.target< mr::function< int(int) > >() == nullptr)
+        CONSTEXPR_ASSERT(f(2) == 4)
+        basic = std::move(f);
+        CONSTEXPR_ASSERT(basic(3) == 6)
+
+        return true;
+    }
+
+    struct MoveOnly {
+        constexpr explicit MoveOnly(int Value) : value(new int(Value)) {
+        }
+        constexpr MoveOnly(MoveOnly&& Other) noexcept : value(std::exchange(Other.value, nullptr)) {
+        }
+        MoveOnly(const MoveOnly&) = delete;
+        constexpr ~MoveOnly() {
+            delete value;
+        }
+
+        constexpr int operator()() const noexcept {
+            return *value;
+        }
+
+        int* value;
+    };
+
+    template < class Storage >
+    constexpr bool TestMoveOnlyPolicy() {
+        using Fn = mr::move_only_function< int(), Storage >;
+        static_assert(!std::is_copy_constructible_v< Fn > && std::is_nothrow_move_constructible_v< Fn >);
+
+        Fn f1 = MoveOnly { 7 };
+        CONSTEXPR_ASSERT(f1() == 7)
+
+        Fn f2 = std::move(f1);
+        CONSTEXPR_ASSERT(!f1)
+        CONSTEXPR_ASSERT(f2() == 7)
+
+        f1 = MoveOnly { 8 };
+        f1.swap(f2);
+        CONSTEXPR_ASSERT(f1() == 7 && f2() == 8)
+        CONSTEXPR_ASSERT(f2.template target< MoveOnly >() != nullptr)
+        return true;
+    }
+
+    // Counts the copies and moves made of it
+    struct Summed {
+        constexpr Summed(std::initializer_list< int > il, int* Copies, int Offset) : copies(Copies), offset(Offset) {
+            std::copy(il.begin(), il.end(), values.begin());
+        }
+
+        constexpr Summed(const Summed& Val) : values(Val.values), copies(Val.copies), offset(Val.offset) {
+            ++*copies;
+        }
+
+        constexpr Summed(Summed&& Val) noexcept : values(Val.values), copies(Val.copies), offset(Val.offset) {
+            ++*copies;
+        }
+
+        constexpr int operator()(int x) const {
+            int Sum = offset + x;
+            for (int v : values) {
+                Sum += v;
+            }
+            return Sum;
+        }
+
+        std::array< int, 8 > values {};
+        int*                 copies;
+        int                  offset;
+    };
+
+    template < class Storage >
+    constexpr bool TestEmplace() {
+        using Fn = mr::basic_function< int(int), Storage >;
+
+        int Copies = 0;
+        Fn  f1 { std::in_place_type< Summed >, { 1, 2, 3 }, &Copies, 4 };
+        CONSTEXPR_ASSERT(f1(0) == 10 && Copies == 0)
+        CONSTEXPR_ASSERT(f1.template target< Summed >()->values[2] == 3)
+
+        Summed& Emplaced = f1.template emplace< Summed >({ 5 }, &Copies, 1);
+        CONSTEXPR_ASSERT(f1(1) == 7 && Copies == 0 && &Emplaced == f1.template target< Summed >())
+
+        f1.template emplace< std::negate< int > >();
+        CONSTEXPR_ASSERT(!f1.template target< Summed >())
+
+        Fn f2 { std::in_place_type< std::negate< int > > };
+        CONSTEXPR_ASSERT(f2(3) == -3)
+
+        mr::function< int(int) > f3 = mr::make_function< int(int), Summed >({ 2, 2 }, &Copies, 0);
+        CONSTEXPR_ASSERT(f3(1) == 5 && Copies == 0)
+
+        static_assert(!std::is_constructible_v< Fn, std::in_place_type_t< Summed >, int* >);
+        mr::move_only_function< int(), Storage > f4 { std::in_place_type< MoveOnly >, 9 };
+        CONSTEXPR_ASSERT(f4() == 9)
+        return true;
+    }
+
+    // Null function pointers and empty erased functions construct an empty mr::function, target() of an empty
+    // function is null
+    constexpr bool TestNullTargets() {
+        using Fn = int (*)(int, int);
+
+        mr::function< int(int, int) > null_fn { static_cast< Fn >(nullptr) };
+        CONSTEXPR_ASSERT(!null_fn && null_fn.target< Fn >() == nullptr)
+
+        using Member = decltype(&ACallable< std::plus< int > >::Do);
+        mr::function< int(ACallable< std::plus< int > >, int, int) > null_member { static_cast< Member >(nullptr) };
+        CONSTEXPR_ASSERT(!null_member && null_member.target< Member >() == nullptr)
+
+        // an empty erased function of another signature or policy is not wrapped
+        mr::function< long(int, int) > empty_long {};
+        mr::function< int(int, int) >  from_long { empty_long };
+        CONSTEXPR_ASSERT(!from_long)
+
+        using Heap_fn = mr::basic_function< int(int, int), mr::heap_storage >;
+        mr::function< int(int, int) > empty {};
+        mr::function< int(int, int) > set { Do< std::plus< int > > };
+        Heap_fn                       from_empty { empty };
+        Heap_fn                       from_set { set };
+        CONSTEXPR_ASSERT(!from_empty && from_set && from_set(1, 2) == 3)
+        CONSTEXPR_ASSERT(empty.target< Fn >() == nullptr && empty.target< ACallable< std::plus< int > > >() == nullptr)
+
+        return true;
+    }
+
+    bool TestEmptyCall() {
+        mr::function< int(int) > f {};
+        try {
+            (void)f(1);
+        } catch (const std::bad_function_call&) {
+            return true;
+        }
+        return false;
+    }
+
+    static_assert(sizeof(mr::basic_function< int(int), mr::heap_storage >) == 4 * sizeof(void*));
+    static_assert(mr::inline_storage< 16 >::stores_inline_v< Tracked< 8 > >);
+    static_assert(!mr::inline_storage< 16 >::stores_inline_v< Tracked< 9 > >);
+
 #ifndef _MSC_VER
     constexpr bool TestInitListOfFunctions() {
         {
@@ -225,6 +505,15 @@ static_assert(test::TestCtorAndCalls());
 static_assert(test::TestGetTarget());
 static_assert(test::TestMove());
 static_assert(test::TestSwap());
+static_assert(test::TestStorage< 1 >());
+static_assert(test::TestStorage< 64 >());
+static_assert(test::TestBind());
+static_assert(test::TestPolicies());
+static_assert(test::TestMoveOnlyPolicy< mr::sbo_storage<> >());
+static_assert(test::TestMoveOnlyPolicy< mr::inline_storage< 8 > >());
+static_assert(test::TestEmplace< mr::sbo_storage<> >());
+static_assert(test::TestEmplace< mr::heap_storage >());
+static_assert(test::TestNullTargets());
 
 #ifndef _MSC_VER
 static_assert(test::TestInitListOfFunctions());
@@ -239,6 +528,16 @@ int main() {
     assert(test::TestGetTarget());
     assert(test::TestMove());
     assert(test::TestSwap());
+    assert(test::TestStorage< 1 >());
+    assert(test::TestStorage< 64 >());
+    assert(test::TestBind());
+    assert(test::TestPolicies());
+    assert(test::TestMoveOnlyPolicy< mr::sbo_storage<> >());
+    assert(test::TestMoveOnlyPolicy< mr::inline_storage< 8 > >());
+    assert(test::TestEmplace< mr::sbo_storage<> >());
+    assert(test::TestEmplace< mr::heap_storage >());
+    assert(test::TestNullTargets());
+    assert(test::TestEmptyCall());
 
 #ifndef _MSC_VER
     assert(test::TestInitListOfFunctions());
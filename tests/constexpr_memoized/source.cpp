@@ -0,0 +1,140 @@
+#include <cassert>
+#include <constexpr_memoized.h>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#define CONSTEXPR_ASSERT(x) \
+    if (!(x)) {             \
+        return false;       \
+    }
+
+namespace test {
+
+    // Naive recursion would need ~10^10 calls, far beyond the constant evaluation step limit
+    constexpr long long Fibonacci(int n) {
+        mr::memoized< long long(int) > fib {};
+        fib = [&fib](int k) { return k < 2 ? static_cast< long long >(k) : fib(k - 1) + fib(k - 2); };
+        return fib(n);
+    }
+
+    constexpr bool TestConstantEvaluation() {
+        CONSTEXPR_ASSERT(Fibonacci(50) == 12586269025ll)
+
+        int                         calls = 0;
+        mr::memoized< int(int, int) > add = [&calls](int a, int b) {
+            ++calls;
+            return a + b;
+        };
+        CONSTEXPR_ASSERT(add(1, 2) == 3 && add(2, 1) == 3 && add(1, 2) == 3)
+        CONSTEXPR_ASSERT(calls == 2 && add.constant_entries() == (std::is_constant_evaluated() ? 2u : 0u))
+        return true;
+    }
+
+    // Equality comparable but not ordered: the constant evaluation table is searched linearly
+    struct Point {
+        int x;
+        int y;
+
+        constexpr bool operator==(const Point&) const = default;
+    };
+
+    constexpr bool TestUnorderedArguments() {
+        int                                                   calls = 0;
+        mr::memoized< int(Point), mr::no_runtime_cache > norm = [&calls](Point p) {
+            ++calls;
+            return p.x * p.x + p.y * p.y;
+        };
+        CONSTEXPR_ASSERT(norm(Point { 3, 4 }) == 25 && norm(Point { 1, 1 }) == 2 && norm(Point { 3, 4 }) == 25)
+        // without a run-time cache every call is evaluated outside of constant evaluation
+        CONSTEXPR_ASSERT(calls == (std::is_constant_evaluated() ? 2 : 3))
+        return true;
+    }
+
+    bool TestRuntimeCache() {
+        int                                       calls = 0;
+        const mr::memoized< std::size_t(std::string) > length = [&calls](const std::string& text) {
+            ++calls;
+            return text.size();
+        };
+        CONSTEXPR_ASSERT(length("memo") == 4 && length("memo") == 4 && length("cache") == 5)
+        CONSTEXPR_ASSERT(calls == 2 && length.constant_entries() == 0)
+
+        // copies hold the same callable and share its results
+        const auto copy = length;
+        CONSTEXPR_ASSERT(copy("memo") == 4 && calls == 2)
+
+        // another object with the same signature does not see them
+        int                                            other_calls = 0;
+        const mr::memoized< std::size_t(std::string) > other = [&other_calls](const std::string& text) {
+            ++other_calls;
+            return text.size() * 2;
+        };
+        CONSTEXPR_ASSERT(other("memo") == 8 && other_calls == 1)
+        CONSTEXPR_ASSERT(length("memo") == 4 && calls == 2)
+
+        // the cache is private to each thread
+        std::thread { [&] { CONSTEXPR_ASSERT(length("memo") == 4) return true; } }.join();
+        CONSTEXPR_ASSERT(calls == 3)
+        return true;
+    }
+
+    bool TestBoundedCache() {
+        int                                                       calls = 0;
+        const mr::memoized< int(int), mr::thread_local_cache< 4 > > square = [&calls](int value) {
+            ++calls;
+            return value * value;
+        };
+        // more keys than slots: older results are replaced, results stay correct
+        for (int round = 0; round < 2; ++round) {
+            for (int i = 0; i < 100; ++i) {
+                CONSTEXPR_ASSERT(square(i) == i * i)
+            }
+        }
+        CONSTEXPR_ASSERT(calls > 100 && calls <= 200)
+
+        int                                                 uncached_calls = 0;
+        const mr::memoized< int(int), mr::no_runtime_cache > uncached = [&uncached_calls](int value) {
+            ++uncached_calls;
+            return value;
+        };
+        CONSTEXPR_ASSERT(uncached(1) == 1 && uncached(1) == 1 && uncached_calls == 2)
+        return true;
+    }
+
+    struct CountedCopies {
+        static inline int copies = 0;
+
+        CountedCopies() = default;
+        CountedCopies(const CountedCopies& rhs) : value(rhs.value) {
+            ++copies;
+        }
+
+        bool operator==(const CountedCopies&) const = default;
+
+        int value { 0 };
+    };
+
+    // Without a run-time cache the arguments are passed through, no key is built from them
+    bool TestUncachedCopies() {
+        const mr::memoized< int(const CountedCopies&), mr::no_runtime_cache > get = [](const CountedCopies& c) {
+            return c.value;
+        };
+        const CountedCopies argument {};
+        CONSTEXPR_ASSERT(get(argument) == 0 && CountedCopies::copies == 0)
+        return true;
+    }
+
+} // namespace test
+
+static_assert(test::TestConstantEvaluation());
+static_assert(test::TestUnorderedArguments());
+
+int main() {
+    assert(test::TestConstantEvaluation());
+    assert(test::TestUnorderedArguments());
+    assert(test::TestRuntimeCache());
+    assert(test::TestBoundedCache());
+    assert(test::TestUncachedCopies());
+}
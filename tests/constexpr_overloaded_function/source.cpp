@@ -0,0 +1,103 @@
+#include <cassert>
+#include <constexpr_overloaded_function.h>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+#define CONSTEXPR_ASSERT(x) \
+    if (!(x)) {             \
+        return false;       \
+    }
+
+namespace test {
+
+    using Handler = mr::overloaded_function< int(int), int(std::string_view), int(double) >;
+
+    struct Visitor {
+        constexpr int operator()(int value) const noexcept {
+            return value + offset;
+        }
+        constexpr int operator()(std::string_view text) const noexcept {
+            return static_cast< int >(text.size()) + offset;
+        }
+        constexpr int operator()(double value) const noexcept {
+            return static_cast< int >(value * 10) + offset;
+        }
+
+        int offset;
+    };
+
+    constexpr bool TestOverloadResolution() {
+        Handler f = Visitor { 100 };
+        CONSTEXPR_ASSERT(f)
+        CONSTEXPR_ASSERT(f(1) == 101)
+        CONSTEXPR_ASSERT(f("four") == 104)
+        CONSTEXPR_ASSERT(f(2.5) == 125)
+
+        // a generic lambda is stored once and serves every signature
+        std::vector< int > calls {};
+        mr::overloaded_function< void(int), void(std::string_view) > g = [&calls](auto value) {
+            if constexpr (std::is_same_v< decltype(value), int >) {
+                calls.push_back(value);
+            } else {
+                calls.push_back(-static_cast< int >(value.size()));
+            }
+        };
+        g(3);
+        g("ab");
+        CONSTEXPR_ASSERT(calls.size() == 2 && calls[0] == 3 && calls[1] == -2)
+
+        return true;
+    }
+
+    constexpr bool TestCopyMoveSwap() {
+        Handler f1 = Visitor { 1 };
+        Handler f2 = f1;
+        CONSTEXPR_ASSERT(f2(1) == 2)
+        CONSTEXPR_ASSERT(f1.target< Visitor >() != f2.target< Visitor >())
+
+        Handler f3 = std::move(f1);
+        CONSTEXPR_ASSERT(!f1)
+        CONSTEXPR_ASSERT(f3("x") == 2)
+
+        Handler f4 = Visitor { 10 };
+        f4.swap(f3);
+        CONSTEXPR_ASSERT(f3(0) == 10)
+        CONSTEXPR_ASSERT(f4(0) == 1)
+
+        f4 = nullptr;
+        CONSTEXPR_ASSERT(!f4)
+        CONSTEXPR_ASSERT(f4.target< Visitor >() == nullptr)
+
+        f4 = Visitor { 5 };
+        CONSTEXPR_ASSERT(f4.target< Visitor >()->offset == 5)
+        return true;
+    }
+
+    constexpr bool TestEmptyCall() {
+        Handler f {};
+        try {
+            (void)f(1);
+        } catch (const std::bad_function_call&) {
+            return true;
+        }
+        return false;
+    }
+
+    // Callables missing one of the signatures are rejected
+    static_assert(std::is_constructible_v< Handler, Visitor >);
+    static_assert(!std::is_constructible_v< Handler, int (*)(int) >);
+
+    // The inline buffer and the table pointer, the operations live in the table
+    static_assert(sizeof(Handler) == 4 * sizeof(void*));
+
+} // namespace test
+
+static_assert(test::TestOverloadResolution());
+static_assert(test::TestCopyMoveSwap());
+
+int main() {
+    assert(test::TestOverloadResolution());
+    assert(test::TestCopyMoveSwap());
+    assert(test::TestEmptyCall());
+}
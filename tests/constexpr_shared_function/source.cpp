@@ -0,0 +1,111 @@
+#include <array>
+#include <cassert>
+#include <constexpr_shared_function.h>
+#include <thread>
+#include <vector>
+
+#define CONSTEXPR_ASSERT(x) \
+    if (!(x)) {             \
+        return false;       \
+    }
+
+namespace test {
+
+    // Heavy state, as captured by fan-out handlers
+    struct Payload {
+        constexpr int operator()(int index) const noexcept {
+            return values[static_cast< std::size_t >(index)];
+        }
+
+        std::array< int, 50 > values {};
+    };
+
+    constexpr Payload MakePayload() {
+        Payload payload {};
+        for (std::size_t i = 0; i < payload.values.size(); ++i) {
+            payload.values[i] = static_cast< int >(i * 2);
+        }
+        return payload;
+    }
+
+    template < class RefCount >
+    constexpr bool TestSharing() {
+        using Handler = mr::shared_function< int(int), RefCount >;
+
+        Handler f1 = MakePayload();
+        CONSTEXPR_ASSERT(f1.use_count() == 1)
+        CONSTEXPR_ASSERT(f1(3) == 6)
+
+        {
+            std::vector< Handler > subscribers(10, f1);
+            CONSTEXPR_ASSERT(f1.use_count() == 11)
+            const Handler& subscriber = subscribers[4];
+            CONSTEXPR_ASSERT(subscriber.template target< Payload >() == std::as_const(f1).template target< Payload >())
+            CONSTEXPR_ASSERT(subscribers[9](5) == 10)
+        }
+        CONSTEXPR_ASSERT(f1.use_count() == 1)
+
+        Handler f2 = std::move(f1);
+        CONSTEXPR_ASSERT(!f1)
+        CONSTEXPR_ASSERT(f1.use_count() == 0)
+        CONSTEXPR_ASSERT(f2.use_count() == 1)
+
+        f1 = f2;
+        f2 = nullptr;
+        CONSTEXPR_ASSERT(f1.use_count() == 1)
+        return true;
+    }
+
+    constexpr bool TestCopyOnWrite() {
+        mr::shared_function< int(int) > f1 = MakePayload();
+        mr::shared_function< int(int) > f2 = f1;
+
+        const Payload* shared = std::as_const(f1).target< Payload >();
+        CONSTEXPR_ASSERT(shared == std::as_const(f2).target< Payload >())
+
+        // writing through f2 detaches it, f1 keeps the original value
+        Payload* own = f2.target< Payload >();
+        CONSTEXPR_ASSERT(own != shared)
+        own->values[0] = 42;
+        CONSTEXPR_ASSERT(f2(0) == 42)
+        CONSTEXPR_ASSERT(f1(0) == 0)
+        CONSTEXPR_ASSERT(f1.use_count() == 1 && f2.use_count() == 1)
+
+        // a unique owner is written in place
+        CONSTEXPR_ASSERT(f2.target< Payload >() == own)
+        CONSTEXPR_ASSERT(f2.target< int (*)(int) >() == nullptr)
+        return true;
+    }
+
+    bool TestConcurrentCopies() {
+        mr::shared_function< int(int) > f = MakePayload();
+
+        std::vector< std::thread > threads {};
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&f] {
+                for (int i = 0; i < 10000; ++i) {
+                    mr::shared_function< int(int) > copy = f;
+                    if (copy(1) != 2) {
+                        std::abort();
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return f.use_count() == 1;
+    }
+
+} // namespace test
+
+static_assert(test::TestSharing< mr::atomic_refcount >());
+static_assert(test::TestSharing< mr::local_refcount >());
+static_assert(test::TestCopyOnWrite());
+
+int main() {
+    assert(test::TestSharing< mr::atomic_refcount >());
+    assert(test::TestSharing< mr::local_refcount >());
+    assert(test::TestCopyOnWrite());
+    assert(test::TestConcurrentCopies());
+}
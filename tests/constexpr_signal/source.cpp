@@ -0,0 +1,106 @@
+#include <atomic>
+#include <cassert>
+#include <constexpr_signal.h>
+#include <thread>
+#include <vector>
+
+#define CONSTEXPR_ASSERT(x) \
+    if (!(x)) {             \
+        return false;       \
+    }
+
+namespace test {
+
+    struct Event {
+        int value;
+    };
+
+    template < class Signal >
+    constexpr bool TestConnectEmitDisconnect() {
+        Signal             signal {};
+        std::vector< int > seen {};
+
+        const auto first  = signal.connect([&seen](const Event& event) { seen.push_back(event.value); });
+        const auto second = signal.connect([&seen](const Event& event) { seen.push_back(event.value * 10); });
+        CONSTEXPR_ASSERT(first != second)
+        CONSTEXPR_ASSERT(signal.size() == 2)
+
+        signal(Event { 1 });
+        CONSTEXPR_ASSERT(seen.size() == 2 && seen[0] == 1 && seen[1] == 10)
+
+        CONSTEXPR_ASSERT(signal.disconnect(first))
+        CONSTEXPR_ASSERT(!signal.disconnect(first))
+        signal.emit(Event { 2 });
+        CONSTEXPR_ASSERT(seen.size() == 3 && seen[2] == 20)
+
+        // empty callables are not connected
+        CONSTEXPR_ASSERT(signal.connect(mr::function< void(const Event&) > {}) == Signal::invalid_connection)
+
+        signal.disconnect_all();
+        CONSTEXPR_ASSERT(signal.empty())
+        return true;
+    }
+
+    constexpr bool TestEditDuringEmit() {
+        mr::local_signal< void(const Event&) > signal {};
+        mr::local_signal< void(const Event&) >::connection_id self = 0;
+
+        int once  = 0;
+        int other = 0;
+        self      = signal.connect([&](const Event&) {
+            ++once;
+            // disconnecting itself and connecting a new subscriber while the list is being walked
+            signal.disconnect(self);
+            signal.connect([&other](const Event&) { ++other; });
+        });
+
+        signal(Event { 0 });
+        CONSTEXPR_ASSERT(once == 1 && other == 0)
+        CONSTEXPR_ASSERT(signal.size() == 1)
+
+        signal(Event { 0 });
+        CONSTEXPR_ASSERT(once == 1 && other == 1)
+        return true;
+    }
+
+    bool TestConcurrentEmit() {
+        mr::signal< void(int) > signal {};
+        std::atomic< long long > total { 0 };
+        std::atomic< bool >      stop { false };
+
+        signal.connect([&total](int value) { total.fetch_add(value, std::memory_order_relaxed); });
+
+        std::vector< std::thread > emitters {};
+        for (int t = 0; t < 3; ++t) {
+            emitters.emplace_back([&] {
+                do {
+                    signal(1);
+                } while (!stop.load(std::memory_order_relaxed));
+            });
+        }
+
+        for (int i = 0; i < 2000; ++i) {
+            const auto id = signal.connect([&total](int value) { total.fetch_add(value, std::memory_order_relaxed); });
+            if (!signal.disconnect(id)) {
+                return false;
+            }
+        }
+
+        stop = true;
+        for (auto& emitter : emitters) {
+            emitter.join();
+        }
+        return signal.size() == 1 && total.load() >= 3;
+    }
+
+} // namespace test
+
+static_assert(test::TestConnectEmitDisconnect< mr::local_signal< void(const test::Event&) > >());
+static_assert(test::TestEditDuringEmit());
+
+int main() {
+    assert(test::TestConnectEmitDisconnect< mr::local_signal< void(const test::Event&) > >());
+    assert(test::TestConnectEmitDisconnect< mr::signal< void(const test::Event&) > >());
+    assert(test::TestEditDuringEmit());
+    assert(test::TestConcurrentEmit());
+}
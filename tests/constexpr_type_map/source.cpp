@@ -0,0 +1,211 @@
+#include <array>
+#include <cassert>
+#include <constexpr_type_map.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define CONSTEXPR_ASSERT(x) \
+    if (!(x)) {             \
+        return false;       \
+    }
+
+namespace test_helpers {
+
+    template < int I >
+    struct Component {
+        constexpr explicit Component(int val = I) : value(val) {
+        }
+
+        int value;
+    };
+
+    struct Position {
+        int x;
+        int y;
+    };
+
+    struct Name {
+        std::array< char, 32 > value {};
+    };
+
+    struct Throwing {
+        explicit Throwing(bool fail) {
+            if (fail) {
+                throw std::runtime_error { "Throwing" };
+            }
+        }
+    };
+
+    // Copies throw once Copies_left reaches zero, Live counts every instance
+    inline int Live        = 0;
+    inline int Copies_left = -1;
+
+    template < int N >
+    struct Tracked {
+        Tracked() {
+            ++Live;
+        }
+
+        Tracked(const Tracked&) {
+            if (Copies_left-- == 0) {
+                throw std::runtime_error { "Tracked" };
+            }
+            ++Live;
+        }
+
+        ~Tracked() {
+            --Live;
+        }
+    };
+
+} // namespace test_helpers
+
+namespace test {
+
+    constexpr bool TestEmplaceAndGet() {
+        mr::type_map map;
+        CONSTEXPR_ASSERT(map.empty())
+        CONSTEXPR_ASSERT(map.get< test_helpers::Position >() == nullptr)
+
+        map.emplace< test_helpers::Position >(1, 2);
+        map.emplace< int >(5);
+        map.emplace< test_helpers::Name >();
+
+        CONSTEXPR_ASSERT(map.size() == 3)
+        CONSTEXPR_ASSERT(map.get< test_helpers::Position >()->y == 2)
+        CONSTEXPR_ASSERT(*map.get< int >() == 5)
+        CONSTEXPR_ASSERT(map.contains< test_helpers::Name >())
+        CONSTEXPR_ASSERT(!map.contains< float >())
+
+        // emplacing an existing type replaces the stored value
+        map.emplace< int >(7);
+        CONSTEXPR_ASSERT(map.size() == 3)
+        CONSTEXPR_ASSERT(*map.get< int >() == 7)
+
+        const mr::type_map& cmap = map;
+        CONSTEXPR_ASSERT(cmap.get< test_helpers::Position >()->x == 1)
+
+        return true;
+    }
+
+    template < int... Is >
+    constexpr bool TestGrowAndErase(std::integer_sequence< int, Is... >) {
+        mr::type_map map;
+        (map.emplace< test_helpers::Component< Is > >(), ...);
+        CONSTEXPR_ASSERT(map.size() == sizeof...(Is))
+        CONSTEXPR_ASSERT(((map.get< test_helpers::Component< Is > >()->value == Is) && ...))
+
+        // drop every even component, the odd ones must still be reachable
+        (((Is % 2 == 0) ? static_cast< void >(map.erase< test_helpers::Component< Is > >()) : void()), ...);
+        CONSTEXPR_ASSERT(map.size() == sizeof...(Is) / 2)
+        CONSTEXPR_ASSERT(((map.contains< test_helpers::Component< Is > >() == (Is % 2 != 0)) && ...))
+        CONSTEXPR_ASSERT(!map.erase< test_helpers::Component< 0 > >())
+
+        map.clear();
+        CONSTEXPR_ASSERT(map.empty())
+        CONSTEXPR_ASSERT(!map.contains< test_helpers::Component< 1 > >())
+
+        return true;
+    }
+
+    constexpr bool TestCopyAndMove() {
+        mr::type_map map;
+        map.emplace< int >(1);
+        map.emplace< test_helpers::Position >(3, 4);
+
+        mr::type_map copy { map };
+        *copy.get< int >() = 2;
+        CONSTEXPR_ASSERT(*map.get< int >() == 1)
+        CONSTEXPR_ASSERT(*copy.get< int >() == 2)
+        CONSTEXPR_ASSERT(copy.get< test_helpers::Position >()->x == 3)
+
+        mr::type_map moved { std::move(copy) };
+        CONSTEXPR_ASSERT(copy.empty())
+        CONSTEXPR_ASSERT(*moved.get< int >() == 2)
+
+        map = moved;
+        CONSTEXPR_ASSERT(*map.get< int >() == 2)
+
+        mr::type_map other;
+        other.swap(map);
+        CONSTEXPR_ASSERT(map.empty())
+        CONSTEXPR_ASSERT(other.size() == 2)
+
+        return true;
+    }
+
+#ifdef __cpp_lib_constexpr_vector
+    constexpr bool TestNonTrivialValues() {
+        mr::type_map map;
+        map.emplace< std::vector< int > >({ 1, 2, 3 });
+        map.get< std::vector< int > >()->push_back(4);
+        CONSTEXPR_ASSERT(map.get< std::vector< int > >()->size() == 4)
+        CONSTEXPR_ASSERT(map.erase< std::vector< int > >())
+
+        return true;
+    }
+#endif // __cpp_lib_constexpr_vector
+
+    // A value whose replacement throws is erased with its key
+    bool TestThrowingReplace() {
+        mr::type_map map;
+        map.emplace< test_helpers::Throwing >(false);
+        map.emplace< test_helpers::Position >(1, 2);
+        bool thrown = false;
+        try {
+            map.emplace< test_helpers::Throwing >(true);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        CONSTEXPR_ASSERT(thrown && !map.contains< test_helpers::Throwing >() && map.size() == 1)
+        CONSTEXPR_ASSERT(map.get< test_helpers::Position >()->y == 2)
+        return true;
+    }
+
+    // A copy that throws part way frees the values already copied
+    bool TestThrowingCopy() {
+        using test_helpers::Tracked;
+        {
+            mr::type_map map;
+            map.emplace< Tracked< 0 > >();
+            map.emplace< Tracked< 1 > >();
+            map.emplace< Tracked< 2 > >();
+            map.emplace< Tracked< 3 > >();
+            CONSTEXPR_ASSERT(test_helpers::Live == 4)
+
+            test_helpers::Copies_left = 2;
+            bool thrown               = false;
+            try {
+                mr::type_map copy { map };
+            } catch (const std::runtime_error&) {
+                thrown = true;
+            }
+            test_helpers::Copies_left = -1;
+            CONSTEXPR_ASSERT(thrown && test_helpers::Live == 4 && map.size() == 4)
+        }
+        CONSTEXPR_ASSERT(test_helpers::Live == 0)
+        return true;
+    }
+
+} // namespace test
+
+static_assert(test::TestEmplaceAndGet());
+static_assert(test::TestGrowAndErase(std::make_integer_sequence< int, 20 > {}));
+static_assert(test::TestCopyAndMove());
+
+#ifdef __cpp_lib_constexpr_vector
+static_assert(test::TestNonTrivialValues());
+#endif // __cpp_lib_constexpr_vector
+
+int main() {
+    assert(test::TestEmplaceAndGet());
+    assert(test::TestGrowAndErase(std::make_integer_sequence< int, 20 > {}));
+    assert(test::TestCopyAndMove());
+    assert(test::TestThrowingReplace());
+    assert(test::TestThrowingCopy());
+
+#ifdef __cpp_lib_constexpr_vector
+    assert(test::TestNonTrivialValues());
+#endif // __cpp_lib_constexpr_vector
+}
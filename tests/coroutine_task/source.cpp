@@ -0,0 +1,246 @@
+#include <array>
+#include <cassert>
+#include <coroutine_task.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define TEST_ASSERT(x) \
+    if (!(x)) {        \
+        return false;  \
+    }
+
+namespace test {
+
+    mr::co_task< int > Square(int value) {
+        co_return value * value;
+    }
+
+    mr::co_task< int > SumOfSquares(int count) {
+        int sum = 0;
+        for (int i = 1; i <= count; ++i) {
+            sum += co_await Square(i);
+        }
+        co_return sum;
+    }
+
+    mr::co_task<> Fail() {
+        throw std::runtime_error { "coroutine" };
+        co_return;
+    }
+
+    bool TestAwaitAndExceptions() {
+        mr::single_thread_executor executor {};
+        TEST_ASSERT(executor.run(SumOfSquares(10)) == 385)
+
+        bool thrown = false;
+        try {
+            executor.run(Fail());
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        TEST_ASSERT(thrown)
+
+        // lazily started: nothing runs until the task is awaited or scheduled
+        int  runs = 0;
+        auto task = [](int& runs) -> mr::co_task<> {
+            ++runs;
+            co_return;
+        }(runs);
+        TEST_ASSERT(runs == 0 && !task.done())
+        executor.run(std::move(task));
+        TEST_ASSERT(runs == 1)
+        return true;
+    }
+
+    mr::co_task< long long > Chain(int length) {
+        long long sum = 0;
+        for (int i = 0; i < length; ++i) {
+            sum += co_await Square(1);
+        }
+        co_return sum;
+    }
+
+    // Each awaited task completes synchronously, the resumption of the awaiter is a tail call
+    bool TestSymmetricTransfer() {
+        mr::single_thread_executor executor {};
+        TEST_ASSERT(executor.run(Chain(100000)) == 100000)
+        return true;
+    }
+
+    mr::co_task< int > ArenaLeaf(std::allocator_arg_t, mr::frame_arena&, int value) {
+        co_return value + 1;
+    }
+
+    mr::co_task< int > ArenaRoot(std::allocator_arg_t, mr::frame_arena& arena, int value) {
+        const std::size_t outer = arena.used();
+        const int         first = co_await ArenaLeaf(std::allocator_arg, arena, value);
+        // the leaf frame was released in LIFO order, the arena is back where it was
+        if (arena.used() != outer) {
+            co_return -1;
+        }
+        co_return first + co_await ArenaLeaf(std::allocator_arg, arena, value);
+    }
+
+    struct CountingAllocator {
+        void* allocate(std::size_t size) {
+            ++allocations;
+            return ::operator new(size);
+        }
+
+        void deallocate(void* ptr, std::size_t size) noexcept {
+            ++deallocations;
+            ::operator delete(ptr, size);
+        }
+
+        int allocations { 0 };
+        int deallocations { 0 };
+    };
+
+    struct Service {
+        mr::co_task< int > Handle(std::allocator_arg_t, CountingAllocator&, int request) {
+            co_return request + offset;
+        }
+
+        int offset;
+    };
+
+    bool TestFrameAllocation() {
+        alignas(std::max_align_t) std::array< std::byte, 4096 > buffer {};
+        mr::frame_arena            arena { buffer };
+        mr::single_thread_executor executor {};
+
+        {
+            auto task = ArenaRoot(std::allocator_arg, arena, 20);
+            TEST_ASSERT(arena.live_blocks() == 1 && arena.used() != 0)
+            TEST_ASSERT(executor.run(std::move(task)) == 42)
+        }
+        TEST_ASSERT(arena.live_blocks() == 0 && arena.used() == 0)
+
+        // frames larger than the arena fail with std::bad_alloc
+        std::array< std::byte, 16 > tiny {};
+        mr::frame_arena             small { tiny };
+        bool                        thrown = false;
+        try {
+            auto task = ArenaLeaf(std::allocator_arg, small, 1);
+        } catch (const std::bad_alloc&) {
+            thrown = true;
+        }
+        TEST_ASSERT(thrown)
+
+        // member coroutines take the allocator after the object parameter
+        CountingAllocator counting {};
+        Service           service { 100 };
+        TEST_ASSERT(executor.run(service.Handle(std::allocator_arg, counting, 1)) == 101)
+        TEST_ASSERT(counting.allocations == 1 && counting.deallocations == 1)
+        return true;
+    }
+
+    // await_suspend returning bool: false resumes the awaiting coroutine at once
+    struct Immediate {
+        bool await_ready() const noexcept {
+            return false;
+        }
+        bool await_suspend(std::coroutine_handle<>) const noexcept {
+            return false;
+        }
+        std::string await_resume() const {
+            return "immediate";
+        }
+    };
+
+    // await_suspend returning void: resumed later by the executor
+    struct Deferred {
+        bool await_ready() const noexcept {
+            return false;
+        }
+        void await_suspend(std::coroutine_handle<> awaiting) const {
+            executor->post(awaiting);
+        }
+        std::string await_resume() const {
+            return "deferred";
+        }
+
+        mr::single_thread_executor* executor;
+    };
+
+    mr::co_task< std::string > Text(std::string value) {
+        co_return value;
+    }
+
+    mr::co_task< std::string > Concatenate(std::vector< mr::any_awaitable< std::string > > parts) {
+        std::string result {};
+        for (auto& part : parts) {
+            result += co_await part;
+        }
+        co_return result;
+    }
+
+    bool TestAnyAwaitable() {
+        static_assert(mr::sbo_storage<>::stores_inline_v< mr::co_task< std::string > >,
+                      "Incorrect behaviour: mr::co_task must be stored inline by mr::any_awaitable");
+
+        mr::single_thread_executor                         executor {};
+        std::vector< mr::any_awaitable< std::string > > parts {};
+        parts.emplace_back(Text("task "));
+        parts.emplace_back(Immediate {});
+        parts.emplace_back(Text(" "));
+        parts.emplace_back(Deferred { &executor });
+
+        mr::any_awaitable< std::string > moved { std::move(parts[2]) };
+        TEST_ASSERT(!parts[2] && moved)
+        parts[2] = std::move(moved);
+
+        TEST_ASSERT(executor.run(Concatenate(std::move(parts))) == "task immediate deferred")
+        return true;
+    }
+
+    mr::co_task<> Worker(mr::single_thread_executor& executor, std::vector< std::string >& log, std::string name) {
+        for (int i = 0; i < 3; ++i) {
+            log.push_back(name + std::to_string(i));
+            co_await executor.schedule();
+        }
+    }
+
+    bool TestExecutor() {
+        mr::single_thread_executor executor {};
+        std::vector< std::string > log {};
+        executor.spawn(Worker(executor, log, "a"));
+        executor.spawn(Worker(executor, log, "b"));
+        TEST_ASSERT(log.empty() && executor.pending() == 2)
+
+        // spawned coroutines interleave at every schedule()
+        TEST_ASSERT(executor.run() == 8)
+        const std::vector< std::string > expected { "a0", "b0", "a1", "b1", "a2", "b2" };
+        TEST_ASSERT(log == expected)
+
+        executor.spawn(Fail());
+        bool thrown = false;
+        try {
+            executor.run();
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        TEST_ASSERT(thrown)
+
+        // a task waiting on something never scheduled cannot complete
+        bool stuck = false;
+        try {
+            executor.run([]() -> mr::co_task<> { co_await std::suspend_always {}; }());
+        } catch (const std::logic_error&) {
+            stuck = true;
+        }
+        TEST_ASSERT(stuck)
+        return true;
+    }
+
+} // namespace test
+
+int main() {
+    assert(test::TestAwaitAndExceptions());
+    assert(test::TestSymmetricTransfer());
+    assert(test::TestFrameAllocation());
+    assert(test::TestAnyAwaitable());
+    assert(test::TestExecutor());
+}
@@ -0,0 +1,177 @@
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <constexpr_any.h>
+#include <constexpr_function.h>
+#include <cstdio>
+#include <cstring>
+#include <erasure_counters.h>
+#include <thread>
+
+#define TEST_ASSERT(x) \
+    if (!(x)) {        \
+        return false;  \
+    }
+
+namespace test {
+
+    struct SmallFn {
+        constexpr int operator()(int x) const {
+            return x + value;
+        }
+
+        int value { 1 };
+    };
+
+    // Too large for the inline storage of mr::function
+    struct LargeFn {
+        constexpr int operator()(int x) const {
+            return x + static_cast< int >(padding.size());
+        }
+
+        std::array< char, 64 > padding {};
+    };
+
+    // Too large for the inline storage of std::any
+    struct LargeValue {
+        std::array< char, 64 > padding {};
+    };
+
+    // Counting does not get in the way of constant evaluation, which is never counted
+    constexpr bool TestConstantEvaluation() {
+        mr::function< int(int) > fn = LargeFn {};
+        mr::function< int(int) > copy { fn };
+        mr::any                  value { 42 };
+        TEST_ASSERT(copy(1) == 65 && mr::any_cast< int >(value) == 42)
+        return true;
+    }
+
+    bool TestFunction() {
+        {
+            mr::function< int(int) > small = SmallFn {};
+            mr::function< int(int) > large = LargeFn {};
+            mr::function< int(int) > copy { large };
+            mr::function< int(int) > moved { std::move(copy) };
+            TEST_ASSERT(small(1) == 2 && large(1) == 65 && moved(2) == 66)
+            TEST_ASSERT(large.target< LargeFn >() != nullptr && large.target< SmallFn >() == nullptr)
+        }
+
+        const mr::erasure_counters Small = mr::erasure_counters_of< SmallFn >();
+        TEST_ASSERT(Small.allocations == 0 && Small.frees == 0 && Small.calls == 1 && Small.cast_misses == 1)
+
+        const mr::erasure_counters Large = mr::erasure_counters_of< LargeFn >();
+        TEST_ASSERT(Large.allocations == 2 && Large.frees == 2)
+        TEST_ASSERT(Large.copies == 1 && Large.moves == 1 && Large.calls == 2 && Large.cast_hits == 1)
+        return true;
+    }
+
+    bool TestAny() {
+        {
+            mr::any value = LargeValue {};
+            mr::any copy { value };
+            mr::any moved { std::move(copy) };
+            TEST_ASSERT(mr::any_cast< LargeValue >(&moved) != nullptr && mr::any_cast< int >(&moved) == nullptr)
+            moved.reset();
+
+            mr::any small { 7 };
+            small = mr::any { 8 };
+        }
+
+        const mr::erasure_counters Large = mr::erasure_counters_of< LargeValue >();
+        TEST_ASSERT(Large.allocations == 2 && Large.frees == 2)
+        TEST_ASSERT(Large.copies == 1 && Large.moves == 1 && Large.cast_hits == 1)
+
+        const mr::erasure_counters Small = mr::erasure_counters_of< int >();
+        TEST_ASSERT(Small.allocations == 0 && Small.frees == 0 && Small.moves == 1 && Small.cast_misses == 1)
+        return true;
+    }
+
+    struct ThreadFn {
+        int operator()() const {
+            return static_cast< int >(padding.size());
+        }
+
+        std::array< char, 64 > padding {};
+    };
+
+    // Counters of a running thread are read while it counts, those of an exited thread are kept
+    bool TestThreads() {
+        std::atomic< bool > counted { false };
+        std::atomic< bool > done { false };
+        std::thread         worker { [&] {
+            mr::function< int() > fn = ThreadFn {};
+            for (int i = 0; i < 100; ++i) {
+                (void)fn();
+            }
+            counted = true;
+            while (!done) {
+                std::this_thread::yield();
+            }
+        } };
+
+        while (!counted) {
+            std::this_thread::yield();
+        }
+        TEST_ASSERT(mr::erasure_counters_of< ThreadFn >().calls == 100)
+        done = true;
+        worker.join();
+
+        mr::function< int() > fn = ThreadFn {};
+        (void)fn();
+        const mr::erasure_counters Merged = mr::erasure_counters_of< ThreadFn >();
+        TEST_ASSERT(Merged.calls == 101 && Merged.allocations == 2 && Merged.frees == 1)
+        return true;
+    }
+
+    bool TestDump() {
+        const auto Types = mr::erasure_counters_snapshot();
+        TEST_ASSERT(!Types.empty() && Types.front().counters.allocations >= Types.back().counters.allocations)
+        TEST_ASSERT(mr::erasure_counters_total().calls >= 101)
+
+        std::FILE* Out = std::tmpfile();
+        TEST_ASSERT(Out)
+        mr::dump_erasure_counters(Out, 3);
+        std::rewind(Out);
+        char      Line[512] {};
+        long long Lines = 0;
+        bool      Total = false;
+        while (std::fgets(Line, sizeof(Line), Out)) {
+            ++Lines;
+            Total = Total || std::strstr(Line, "total of") != nullptr;
+        }
+        std::fclose(Out);
+        TEST_ASSERT(Total && Lines == 5)
+        return true;
+    }
+
+    // Held by namespace-scope objects, destroyed after this thread's counters
+    struct GlobalFn {
+        int operator()(int x) const {
+            return x + static_cast< int >(padding.size());
+        }
+
+        std::array< char, 64 > padding {};
+    };
+
+    struct GlobalValue {
+        std::array< char, 64 > padding {};
+    };
+
+} // namespace test
+
+mr::any                  Global_value {};
+mr::function< int(int) > Global_fn {};
+
+static_assert(test::TestConstantEvaluation());
+
+int main() {
+    assert(test::TestFunction());
+    assert(test::TestAny());
+    assert(test::TestThreads());
+    assert(test::TestDump());
+
+    // Freed at exit, once the counters of this thread are gone
+    Global_value = test::GlobalValue {};
+    Global_fn    = test::GlobalFn {};
+    assert(Global_fn(1) == 65);
+}
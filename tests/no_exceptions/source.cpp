@@ -0,0 +1,112 @@
+#include <array>
+#include <cassert>
+#include <constexpr_any.h>
+#include <constexpr_batch_function.h>
+#include <constexpr_dispatch_table.h>
+#include <constexpr_function.h>
+#include <constexpr_overloaded_function.h>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <span>
+#include <string_view>
+
+#define CONSTEXPR_ASSERT(x) \
+    if (!(x)) {             \
+        return false;       \
+    }
+
+static_assert(!mr::detail::exceptions_enabled, "Incorrect behaviour: no_exceptions must build without exceptions!");
+
+namespace test {
+
+    struct Adder {
+        constexpr int operator()(int x) const {
+            return x + value;
+        }
+
+        int value;
+    };
+
+    constexpr bool TestTryAnyCast() {
+        mr::any value { 7 };
+        CONSTEXPR_ASSERT(mr::try_any_cast< int >(value) == 7)
+        CONSTEXPR_ASSERT(mr::try_any_cast< const int& >(value) == 7)
+        CONSTEXPR_ASSERT(!mr::try_any_cast< long >(value))
+
+        const mr::any& const_value = value;
+        CONSTEXPR_ASSERT(mr::try_any_cast< int >(const_value) == 7)
+        CONSTEXPR_ASSERT(mr::try_any_cast< int >(std::move(value)) == 7)
+
+        value.reset();
+        CONSTEXPR_ASSERT(!mr::try_any_cast< int >(value))
+
+        // a matching any_cast by value does not need exceptions
+        mr::any other { 3.5 };
+        CONSTEXPR_ASSERT(mr::any_cast< double >(other) == 3.5)
+        return true;
+    }
+
+    constexpr bool TestFunction() {
+        mr::function< int(int) > fn = Adder { 2 };
+        CONSTEXPR_ASSERT(fn(1) == 3)
+
+        mr::function< int(int) > copy { fn };
+        fn = nullptr;
+        CONSTEXPR_ASSERT(!fn && copy(2) == 4)
+
+        copy.emplace< Adder >(10);
+        CONSTEXPR_ASSERT(copy(1) == 11)
+        return true;
+    }
+
+    // The headers built on mr::function report their run-time failures the same way
+    constexpr bool TestDerivedHeaders() {
+        constexpr auto table = mr::make_dispatch_table< int(int) >(mr::dispatch_entry { "add", Adder { 1 } },
+                                                                   mr::dispatch_entry { "twice", Adder { 2 } });
+        CONSTEXPR_ASSERT(table("add", 1) == 2 && table("twice", 1) == 3)
+
+        mr::overloaded_function< int(int), int(std::string_view) > overloaded = [](auto value) {
+            if constexpr (std::is_same_v< decltype(value), int >) {
+                return value;
+            } else {
+                return static_cast< int >(value.size());
+            }
+        };
+        CONSTEXPR_ASSERT(overloaded(4) == 4 && overloaded(std::string_view { "abc" }) == 3)
+
+        mr::batch_function< int(int) > batch = Adder { 3 };
+        std::array< int, 3 >           in { 1, 2, 3 };
+        std::array< int, 3 >           out {};
+        batch(std::span< int > { out }, std::span< const int > { in });
+        CONSTEXPR_ASSERT(out[2] == 6)
+        return true;
+    }
+
+    [[noreturn]] void ExpectedTerminate() {
+        std::puts("terminated on empty call");
+        std::_Exit(EXIT_SUCCESS);
+    }
+
+    int TestEmptyCall() {
+        std::set_terminate(&ExpectedTerminate);
+        const mr::function< int(int) > fn {};
+        (void)fn(1);
+        std::puts("empty call returned");
+        return EXIT_FAILURE;
+    }
+
+} // namespace test
+
+static_assert(test::TestTryAnyCast());
+static_assert(test::TestFunction());
+static_assert(test::TestDerivedHeaders());
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::string_view { argv[1] } == "empty-call") {
+        return test::TestEmptyCall();
+    }
+    assert(test::TestTryAnyCast());
+    assert(test::TestFunction());
+    assert(test::TestDerivedHeaders());
+}
@@ -0,0 +1,113 @@
+#include <array>
+#include <cassert>
+#include <constexpr_function.h>
+#include <string>
+#include <utility>
+
+#define CONSTEXPR_ASSERT(x) \
+    if (!(x)) {             \
+        return false;       \
+    }
+
+namespace test {
+
+    template < int I >
+    struct Small {
+        constexpr int operator()(int x) const {
+            return x * I + offset;
+        }
+
+        int offset;
+    };
+
+    // Too large for the inline buffer
+    template < int I >
+    struct Large {
+        constexpr int operator()(int x) const {
+            return x * I + values[3];
+        }
+
+        std::array< int, 16 > values;
+    };
+
+    struct NonTrivial {
+        int operator()(int x) const {
+            return x + static_cast< int >(text.size());
+        }
+
+        std::string text;
+    };
+
+    // Exposes the copy, move and destroy thunk of its target
+    template < class Storage = mr::sbo_storage<>, class Ownership = mr::unique_ownership >
+    struct probe : mr::basic_function< int(int), Storage, Ownership > {
+        using mr::basic_function< int(int), Storage, Ownership >::basic_function;
+
+        auto thunk() const {
+            return this->do_op;
+        }
+    };
+
+    static_assert(mr::detail::constexpr_function_shares_thunks_v< Small< 1 > >);
+    static_assert(mr::detail::constexpr_function_shares_thunks_v< int (*)(int) >);
+    static_assert(!mr::detail::constexpr_function_shares_thunks_v< NonTrivial >);
+
+    // Constant evaluation keeps a thunk per type
+    constexpr bool TestConstantEvaluation() {
+        mr::function< int(int) > small = Small< 2 > { 1 };
+        mr::function< int(int) > large = Large< 3 > { { 0, 0, 0, 4 } };
+        mr::function< int(int) > copy { small };
+        CONSTEXPR_ASSERT(small(1) == 3 && large(1) == 7 && copy(2) == 5)
+        copy = std::move(large);
+        CONSTEXPR_ASSERT(!large && copy(1) == 7 && copy.target< Large< 3 > >()->values[3] == 4)
+        return true;
+    }
+
+    template < class Storage, class Ownership >
+    bool TestSharing() {
+        using Fn = probe< Storage, Ownership >;
+
+        Fn small_1 = Small< 1 > { 10 };
+        Fn small_2 = Small< 2 > { 20 };
+        Fn large_1 = Large< 1 > { { 0, 0, 0, 5 } };
+        Fn large_2 = Large< 2 > { { 0, 0, 0, 6 } };
+        CONSTEXPR_ASSERT(small_1.thunk() == small_2.thunk() && large_1.thunk() == large_2.thunk())
+        CONSTEXPR_ASSERT(small_1.thunk() != large_1.thunk())
+
+        // type identity and calls stay per type
+        CONSTEXPR_ASSERT(small_1(1) == 11 && small_2(1) == 22 && large_1(1) == 6 && large_2(1) == 8)
+        CONSTEXPR_ASSERT(small_1.template target< Small< 1 > >()->offset == 10)
+        CONSTEXPR_ASSERT(!small_1.template target< Small< 2 > >() && !large_2.template target< Large< 1 > >())
+
+        Fn copy { large_2 };
+        Fn moved { std::move(small_2) };
+        CONSTEXPR_ASSERT(copy(1) == 8 && moved(1) == 22 && !small_2)
+        CONSTEXPR_ASSERT(copy.template target< Large< 2 > >()->values[3] == 6)
+
+        copy.swap(moved);
+        CONSTEXPR_ASSERT(copy(2) == 24 && moved(2) == 10)
+        copy.template emplace< Small< 3 > >(1);
+        CONSTEXPR_ASSERT(copy(1) == 4 && copy.thunk() == small_1.thunk())
+        return true;
+    }
+
+    bool TestNonTrivial() {
+        probe<> trivial    = Small< 1 > { 0 };
+        probe<> nontrivial = NonTrivial { "four" };
+        probe<> copy { nontrivial };
+        CONSTEXPR_ASSERT(trivial.thunk() != nontrivial.thunk() && copy(1) == 5)
+        return true;
+    }
+
+} // namespace test
+
+static_assert(test::TestConstantEvaluation());
+
+int main() {
+    assert(test::TestConstantEvaluation());
+    assert((test::TestSharing< mr::sbo_storage<>, mr::unique_ownership >()));
+    assert((test::TestSharing< mr::heap_storage, mr::unique_ownership >()));
+    assert((test::TestSharing< mr::heap_storage, mr::shared_ownership<> >()));
+    assert((test::TestSharing< mr::inline_storage< 64 >, mr::unique_ownership >()));
+    assert(test::TestNonTrivial());
+}
@@ -0,0 +1,91 @@
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <task_pool.h>
+#include <vector>
+
+#define TEST_ASSERT(x) \
+    if (!(x)) {        \
+        return false;  \
+    }
+
+namespace test {
+
+    bool TestSubmitAndWait() {
+        mr::task_pool      pool { 4 };
+        std::atomic< int > sum { 0 };
+        for (int i = 1; i <= 1000; ++i) {
+            pool.submit([&sum, i] { sum.fetch_add(i, std::memory_order_relaxed); });
+        }
+        pool.wait_idle();
+        TEST_ASSERT(sum.load() == 500500)
+        TEST_ASSERT(pool.size() == 4)
+        return true;
+    }
+
+    bool TestMoveOnlyTasks() {
+        mr::task_pool      pool { 2 };
+        std::atomic< int > sum { 0 };
+        for (int i = 0; i < 100; ++i) {
+            pool.submit([&sum, value = std::make_unique< int >(i)] { sum.fetch_add(*value); });
+        }
+        pool.wait_idle();
+        TEST_ASSERT(sum.load() == 4950)
+        return true;
+    }
+
+    // Tasks spawning tasks fill the workers' own deques, which the other workers steal from
+    void Spawn(mr::task_pool& pool, std::atomic< int >& leaves, int depth) {
+        if (depth == 0) {
+            leaves.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        pool.submit([&pool, &leaves, depth] { Spawn(pool, leaves, depth - 1); });
+        pool.submit([&pool, &leaves, depth] { Spawn(pool, leaves, depth - 1); });
+    }
+
+    bool TestNestedSubmission() {
+        mr::task_pool      pool { 4 };
+        std::atomic< int > leaves { 0 };
+        pool.submit([&pool, &leaves] { Spawn(pool, leaves, 14); });
+        pool.wait_idle();
+        TEST_ASSERT(leaves.load() == 1 << 14)
+        return true;
+    }
+
+    bool TestBatchSubmission() {
+        mr::task_pool      pool { 3 };
+        std::atomic< int > count { 0 };
+
+        std::vector< mr::task > batch {};
+        for (int i = 0; i < 5000; ++i) {
+            batch.emplace_back([&count] { count.fetch_add(1, std::memory_order_relaxed); });
+        }
+        batch.emplace_back(nullptr);
+        pool.submit_batch(batch);
+        pool.wait_idle();
+        TEST_ASSERT(count.load() == 5000)
+        return true;
+    }
+
+    bool TestDestructorDrains() {
+        std::atomic< int > count { 0 };
+        {
+            mr::task_pool pool { 2 };
+            for (int i = 0; i < 2000; ++i) {
+                pool.submit([&count] { count.fetch_add(1, std::memory_order_relaxed); });
+            }
+        }
+        TEST_ASSERT(count.load() == 2000)
+        return true;
+    }
+
+} // namespace test
+
+int main() {
+    assert(test::TestSubmitAndWait());
+    assert(test::TestMoveOnlyTasks());
+    assert(test::TestNestedSubmission());
+    assert(test::TestBatchSubmission());
+    assert(test::TestDestructorDrains());
+}
@@ -0,0 +1,179 @@
+#include <cassert>
+#include <stdexcept>
+#include <string_view>
+#include <traced_function.h>
+#include <vector>
+
+#define CONSTEXPR_ASSERT(x) \
+    if (!(x)) {             \
+        return false;       \
+    }
+
+namespace test {
+
+    struct Adder {
+        constexpr int operator()(int x) const {
+            return x + value;
+        }
+
+        int value { 1 };
+    };
+
+    struct Thrower {
+        int operator()(int) const {
+            throw std::runtime_error { "thrower" };
+        }
+    };
+
+    // Records every hook call
+    struct recording_tracer {
+        struct event {
+            bool             begin;
+            mr::type_id      type;
+            std::string_view name;
+            int              token;
+        };
+
+        using token = int;
+
+        inline static std::vector< event > events {};
+
+        template < class C >
+        static token begin(const mr::trace_site& Site) noexcept {
+            const int Token = static_cast< int >(events.size());
+            events.push_back(event { true, Site.type, Site.name, Token });
+            return Token;
+        }
+
+        template < class C >
+        static void end(const mr::trace_site& Site, token Token) noexcept {
+            events.push_back(event { false, Site.type, Site.name, Token });
+        }
+    };
+
+    using traced = mr::traced_function< int(int), recording_tracer >;
+
+    constexpr int Square(int x) {
+        return x * x;
+    }
+
+    // Constant evaluation calls the callable without its hooks
+    constexpr bool TestConstantEvaluation() {
+        traced fn = Adder { 2 };
+        CONSTEXPR_ASSERT(fn(1) == 3)
+        traced copy { fn };
+        fn = Square;
+        CONSTEXPR_ASSERT(fn(3) == 9 && copy(3) == 5)
+        CONSTEXPR_ASSERT(fn.target< int (*)(int) >() != nullptr && copy.target< Adder >()->value == 2)
+
+        traced emplaced { std::in_place_type< Adder >, 4 };
+        CONSTEXPR_ASSERT(emplaced(1) == 5)
+        emplaced.emplace< Adder >(6).value += 1;
+        CONSTEXPR_ASSERT(emplaced(1) == 8 && emplaced.target< Adder >()->value == 7)
+        return true;
+    }
+
+    bool TestHooks() {
+        recording_tracer::events.clear();
+        traced fn = Adder { 2 };
+        CONSTEXPR_ASSERT(fn(1) == 3)
+        CONSTEXPR_ASSERT(recording_tracer::events.size() == 2)
+
+        const auto& Begin = recording_tracer::events[0];
+        const auto& End   = recording_tracer::events[1];
+        CONSTEXPR_ASSERT(Begin.begin && !End.begin && Begin.token == End.token)
+        CONSTEXPR_ASSERT(Begin.type == mr::type_id_of< Adder >() && End.type == Begin.type)
+        CONSTEXPR_ASSERT(Begin.name == "test::Adder")
+
+        // end is reached when the call throws
+        fn = Thrower {};
+        bool thrown = false;
+        try {
+            (void)fn(1);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        CONSTEXPR_ASSERT(thrown && recording_tracer::events.size() == 4 && !recording_tracer::events[3].begin)
+        CONSTEXPR_ASSERT(recording_tracer::events[3].type == mr::type_id_of< Thrower >())
+        return true;
+    }
+
+    bool TestEmpty() {
+        int (*null)(int) = nullptr;
+        traced fn { null };
+        CONSTEXPR_ASSERT(!fn)
+        fn = nullptr;
+        CONSTEXPR_ASSERT(!fn)
+
+        // The tracing wrapper is as large as the callable, so it is stored inline when the callable would be
+        static_assert(sizeof(mr::detail::traced_callable< Adder, recording_tracer >) == sizeof(Adder),
+                      "Incorrect behaviour: tracing must not grow the stored callable");
+        return true;
+    }
+
+    bool TestHistogram() {
+        mr::latency_histogram histogram {};
+        for (std::uint64_t value = 1; value <= 1000; ++value) {
+            histogram.record(value);
+        }
+        CONSTEXPR_ASSERT(histogram.count() == 1000 && histogram.max() == 1000)
+        CONSTEXPR_ASSERT(histogram.mean() > 500. && histogram.mean() < 501.)
+
+        // within one sub-bucket, 1/16, of the exact percentile
+        const auto p50 = histogram.value_at_percentile(50.);
+        const auto p99 = histogram.value_at_percentile(99.);
+        CONSTEXPR_ASSERT(p50 >= 500 && p50 <= 500 + 500 / 16)
+        CONSTEXPR_ASSERT(p99 >= 990 && p99 <= 1000)
+        CONSTEXPR_ASSERT(histogram.value_at_percentile(100.) == 1000)
+
+        std::uint64_t counted = 0;
+        std::uint64_t last    = 0;
+        bool          ordered = true;
+        histogram.for_each_bucket([&](std::uint64_t lowest, std::uint64_t highest, std::uint64_t count) {
+            ordered = ordered && lowest >= last && highest >= lowest;
+            last    = highest + 1;
+            counted += count;
+        });
+        CONSTEXPR_ASSERT(ordered && counted == 1000)
+
+        for (std::size_t i = 0; i < mr::latency_histogram::Bucket_count; ++i) {
+            const auto lowest = mr::latency_histogram::bucket_lowest(i);
+            CONSTEXPR_ASSERT(mr::latency_histogram::bucket_index(lowest) == i)
+            CONSTEXPR_ASSERT(mr::latency_histogram::bucket_index(mr::latency_histogram::bucket_highest(i)) == i)
+        }
+        return true;
+    }
+
+    struct Sampled {
+        int operator()(int x) const {
+            return x + 1;
+        }
+    };
+
+    bool TestSampling() {
+        using tracer = mr::sampled_latency< 4, mr::steady_clock_source >;
+        mr::traced_function< int(int), tracer > fn = Sampled {};
+        for (int i = 0; i < 100; ++i) {
+            CONSTEXPR_ASSERT(fn(i) == i + 1)
+        }
+        CONSTEXPR_ASSERT(tracer::histogram< Sampled >().count() == 25)
+
+        bool listed = false;
+        tracer::for_each([&](const mr::trace_site& site, const mr::latency_histogram& histogram) {
+            listed = listed || (site.type == mr::type_id_of< Sampled >() && histogram.count() == 25);
+        });
+        CONSTEXPR_ASSERT(listed)
+        return true;
+    }
+
+} // namespace test
+
+static_assert(test::TestConstantEvaluation());
+
+int main() {
+    assert(test::TestConstantEvaluation());
+    assert(test::TestHooks());
+    assert(test::TestEmpty());
+    assert(test::TestHistogram());
+    assert(test::TestSampling());
+}
@@ -0,0 +1,76 @@
+// GCC 12 does not find these declarations through the module when instantiating its templates
+#include <new>
+#include <optional>
+#include <tuple>
+#include <typeinfo>
+
+#include <cassert>
+#include <functional>
+#include <utility>
+
+import mr.type_erasure;
+
+#define CONSTEXPR_ASSERT(x) \
+    if (!(x)) {             \
+        return false;       \
+    }
+
+namespace test {
+
+    struct Adder {
+        constexpr int operator()(int x) const {
+            return x + value;
+        }
+
+        int value;
+    };
+
+    constexpr int Multiply(int lhs, int rhs) {
+        return lhs * rhs;
+    }
+
+    constexpr bool TestAny() {
+        mr::any value { 3 };
+        CONSTEXPR_ASSERT(mr::any_cast< int >(value) == 3 && !mr::try_any_cast< long >(value))
+
+        mr::any other = mr::make_any< Adder >(4);
+        CONSTEXPR_ASSERT(mr::any_cast< Adder >(&other)->value == 4 && !mr::any_cast< Adder >(&value))
+        CONSTEXPR_ASSERT(mr::type_id_of< Adder >() != mr::type_id_of< int >())
+        return true;
+    }
+
+    constexpr bool TestFunction() {
+        mr::function deduced = Adder { 2 };
+        CONSTEXPR_ASSERT(deduced(1) == 3)
+
+        mr::function< int(int) > emplaced { std::in_place_type< Adder >, 5 };
+        CONSTEXPR_ASSERT(emplaced(1) == 6 && emplaced.holds< Adder >())
+
+        mr::basic_function< int(int), mr::heap_storage > bound = mr::bind_front(Multiply, 3);
+        CONSTEXPR_ASSERT(bound(2) == 6)
+
+        mr::function< int(int) > moved = std::move(emplaced);
+        CONSTEXPR_ASSERT(emplaced == nullptr && moved(0) == 5)
+        return true;
+    }
+
+    bool TestEmptyCall() {
+        const mr::function< int() > empty {};
+        try {
+            (void)empty();
+        } catch (const std::bad_function_call&) {
+            return true;
+        }
+        return false;
+    }
+
+} // namespace test
+
+static_assert(test::TestAny());
+static_assert(test::TestFunction());
+
+int main() {
+    assert(test::TestAny());
+    assert(test::TestFunction());
+    assert(test::TestEmptyCall());
+}